@@ -39,6 +39,12 @@ case "$1" in
         ../vendor/flamegraph/stackcollapse-perf.pl perf.trace | ../vendor/flamegraph/flamegraph.pl > perf.svg
         $BROWSER perf.svg
         ;;
+    "-f")
+        shift
+        TREZOR_FRAMETRACE=frames.trace ../$EXE $ARGS $* $MAIN
+        ../tools/frametrace-collapse frames.trace | ../vendor/flamegraph/flamegraph.pl > frames.svg
+        $BROWSER frames.svg
+        ;;
     *)
         ../$EXE $ARGS $* $MAIN
 esac
@@ -51,24 +51,33 @@ bool check_sdcard(void)
     }
 }
 
+// number of SD card blocks read at once, 16 KiB
+#define COPY_BLOCKS 32
+
 bool copy_sdcard(void)
 {
+    static uint32_t buf[COPY_BLOCKS * SDCARD_BLOCK_SIZE / sizeof(uint32_t)];
+
+    sdcard_power_on();
+
+    image_header hdr;
+    if (sdcard_read_blocks(buf, 0, 1) != SD_OK || !image_parse_header((const uint8_t *)buf, IMAGE_MAGIC, IMAGE_MAXSIZE, &hdr)) {
+        DPRINTLN("invalid header");
+        sdcard_power_off();
+        return false;
+    }
+    const uint32_t total = HEADER_SIZE + hdr.codelen;
 
     DPRINT("erasing flash ");
 
-    // erase flash (except boardloader)
-    HAL_FLASH_Unlock();
-    FLASH_EraseInitTypeDef EraseInitStruct;
-    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
-                           FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
-    EraseInitStruct.TypeErase = FLASH_TYPEERASE_SECTORS;
-    EraseInitStruct.VoltageRange = FLASH_VOLTAGE_RANGE_3;
-    EraseInitStruct.NbSectors = 1;
-    uint32_t SectorError = 0;
-    for (int i = 2; i < 12; i++) {
-        EraseInitStruct.Sector = i;
-        if (HAL_FLASHEx_Erase(&EraseInitStruct, &SectorError) != HAL_OK) {
-            HAL_FLASH_Lock();
+    // erase flash (except boardloader) up to the end of the new bootloader,
+    // the storage sectors in front of it are always wiped
+    flash_unlock();
+    const int last = flash_sector_of(BOOTLOADER_START + total - 1);
+    for (int i = 2; i <= last; i++) {
+        if (!flash_erase_sector(i)) {
+            flash_lock();
+            sdcard_power_off();
             DPRINTLN(" failed");
             return false;
         }
@@ -78,34 +87,22 @@ bool copy_sdcard(void)
 
     DPRINTLN("copying new bootloader from SD card");
 
-    sdcard_power_on();
-
     // copy bootloader from SD card to Flash
-    uint32_t buf[SDCARD_BLOCK_SIZE / sizeof(uint32_t)];
-    sdcard_read_blocks((uint8_t *)buf, 0, 1);
-
-    image_header hdr;
-    if (!image_parse_header((const uint8_t *)buf, IMAGE_MAGIC, IMAGE_MAXSIZE, &hdr)) {
-        DPRINTLN("invalid header");
-        sdcard_power_off();
-        HAL_FLASH_Lock();
-        return false;
-    }
-
-    for (int i = 0; i < (HEADER_SIZE + hdr.codelen) / SDCARD_BLOCK_SIZE; i++) {
-        sdcard_read_blocks((uint8_t *)buf, i, 1);
-        for (int j = 0; j < SDCARD_BLOCK_SIZE / sizeof(uint32_t); j++) {
-            if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, BOOTLOADER_START + i * SDCARD_BLOCK_SIZE + j * sizeof(uint32_t), buf[j]) != HAL_OK) {
-                DPRINTLN("copy failed");
-                sdcard_power_off();
-                HAL_FLASH_Lock();
-                return false;
-            }
+    for (uint32_t pos = 0; pos < total; pos += sizeof(buf)) {
+        uint32_t n = total - pos;
+        if (n > sizeof(buf)) n = sizeof(buf);
+        if (sdcard_read_blocks(buf, pos / SDCARD_BLOCK_SIZE, n / SDCARD_BLOCK_SIZE) != SD_OK ||
+            !flash_write_words(BOOTLOADER_START + pos, buf, n / sizeof(uint32_t))) {
+            DPRINTLN("copy failed");
+            sdcard_power_off();
+            flash_lock();
+            return false;
         }
+        image_progress_bar(pos + n, total);
     }
 
     sdcard_power_off();
-    HAL_FLASH_Lock();
+    flash_lock();
 
     DPRINTLN("done");
 
@@ -125,7 +122,7 @@ void check_and_jump(void)
         return;
     }
 
-    if (image_check_signature((const uint8_t *)BOOTLOADER_START, &hdr, NULL)) {
+    if (image_check_signature((const uint8_t *)BOOTLOADER_START, &hdr, NULL, image_progress_bar)) {
         DPRINTLN("valid bootloader signature");
 
         // TODO: remove debug wait
@@ -12,9 +12,7 @@
 #include "version.h"
 
 #include "messages.h"
-
-#define IMAGE_MAGIC   0x465A5254 // TRZF
-#define IMAGE_MAXSIZE (7 * 128 * 1024)
+#include "upload.h"
 
 void pendsv_isr_handler(void) {
     __fatal_error("pendsv");
@@ -73,12 +71,13 @@ void check_and_jump(void)
         return;
     }
 
-    if (image_check_signature((const uint8_t *)(FIRMWARE_START + vhdr.hdrlen), &hdr, &vhdr)) {
-        DPRINTLN("valid firmware signature");
+    // vendor header is authentic at this point, so show the vendor screen
+    // right away and verify the firmware while it is being displayed
+    display_vendor(vhdr.vimg, (const char *)vhdr.vstr, vhdr.vstr_len, hdr.version);
 
-        display_vendor(vhdr.vimg, (const char *)vhdr.vstr, vhdr.vstr_len, hdr.version);
+    if (image_check_signature((const uint8_t *)(FIRMWARE_START + vhdr.hdrlen), &hdr, &vhdr, image_progress_bar)) {
+        // no console output here, it would repaint over the vendor screen
         HAL_Delay(1000); // TODO: remove?
-        DPRINTLN("JUMP!");
         jump_to(FIRMWARE_START + vhdr.hdrlen + HEADER_SIZE);
 
     } else {
@@ -142,6 +141,51 @@ int usb_init_all(void) {
     return 0;
 }
 
+static bool parse_varint(const uint8_t *buf, uint32_t *pos, uint32_t *val)
+{
+    *val = 0;
+    for (int shift = 0; shift < 32 && *pos < 64; shift += 7) {
+        uint8_t b = buf[(*pos)++];
+        *val |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// called when the last report of a FirmwareUpload message has arrived,
+// the next chunk is requested while the tail of this one is programmed
+static void upload_chunk_done(int iface)
+{
+    if (!upload_poll()) {
+        DPRINTLN("upload failed");
+        send_msg_Failure(iface);
+        return;
+    }
+    uint32_t received = upload_received();
+    uint32_t total = upload_total();
+    if (total == 0 || received < total) {
+        if (total > 0) {
+            image_progress_bar(received, total);
+        }
+        uint32_t len = UPLOAD_CHUNK_SIZE;
+        if (total > 0 && total - received < len) {
+            len = total - received;
+        }
+        send_msg_FirmwareRequest(iface, received, len);
+        return;
+    }
+    if (upload_finish()) {
+        image_progress_bar(total, total);
+        DPRINTLN("valid firmware signature");
+        send_msg_Success(iface);
+    } else {
+        DPRINTLN("invalid firmware");
+        send_msg_Failure(iface);
+    }
+}
+
 void mainloop(void)
 {
     if (0 != flash_init()) {
@@ -154,9 +198,15 @@ void mainloop(void)
 
     uint8_t buf[64];
 
+    // FirmwareUpload message being received
+    uint32_t msg_remaining = 0;
+    uint32_t data_remaining = 0;
+
     for (;;) {
         int iface = usb_hid_read_select(1); // 1ms timeout
         if (iface < 0) {
+            // program the flash while waiting for the next report
+            upload_poll();
             continue;
         }
         ssize_t r = usb_hid_read(iface, buf, sizeof(buf));
@@ -164,14 +214,27 @@ void mainloop(void)
         if (r != sizeof(buf)) {
             continue;
         }
+        // continuation of the FirmwareUpload message
+        if (msg_remaining > 0) {
+            if (buf[0] != '?') {
+                continue;
+            }
+            uint32_t n = msg_remaining < 63 ? msg_remaining : 63;
+            uint32_t d = data_remaining < n ? data_remaining : n;
+            upload_write(buf + 1, d);
+            msg_remaining -= n;
+            data_remaining -= d;
+            if (msg_remaining == 0) {
+                upload_chunk_done(iface);
+            }
+            continue;
+        }
         // invalid header
         if (buf[0] != '?' || buf[1] != '#' || buf[2] != '#') {
             continue;
         }
         uint16_t msg_id = (buf[3] << 8) + buf[4];
         uint32_t msg_size = (buf[5] << 24) + (buf[6] << 16) + (buf[7] << 8) + buf[8];
-        (void)msg_size;
-        static uint32_t chunk = 0;
         switch (msg_id) {
             case 0: // Initialize
                 DPRINTLN("received Initialize");
@@ -183,19 +246,28 @@ void mainloop(void)
                 break;
             case 6: // FirmwareErase
                 DPRINTLN("received FirmwareErase");
-                send_msg_FirmwareRequest(iface, 0, 128 * 1024);
-                chunk = 0;
+                // sectors are erased on the fly, when the data reaches them
+                upload_start();
+                send_msg_FirmwareRequest(iface, 0, UPLOAD_CHUNK_SIZE);
                 break;
-            case 7: // FirmwareUpload
-                DPRINTLN("received FirmwareUpload");
-                // TODO: process chunk
-                chunk++;
-                if (chunk <= 3) {
-                    send_msg_FirmwareRequest(iface, chunk * 128 * 1024, 128 * 1024);
-                } else {
-                    send_msg_Success(iface);
+            case 7: { // FirmwareUpload
+                // payload (field 1, length-delimited) is expected first
+                uint32_t pos = 9;
+                uint32_t len = 0;
+                if (buf[pos++] != 0x0A || !parse_varint(buf, &pos, &len) || len > msg_size) {
+                    send_msg_Failure(iface);
+                    break;
+                }
+                msg_size = msg_size > sizeof(buf) - 9 ? msg_size - (sizeof(buf) - 9) : 0;
+                uint32_t d = sizeof(buf) - pos < len ? sizeof(buf) - pos : len;
+                upload_write(buf + pos, d);
+                msg_remaining = msg_size;
+                data_remaining = len - d;
+                if (msg_remaining == 0) {
+                    upload_chunk_done(iface);
                 }
                 break;
+            }
             default:
                 DPRINTLN("received unknown message");
                 send_msg_Failure(iface);
@@ -1,7 +1,6 @@
 #include <assert.h>
 #include <string.h>
 
-#include "usb.h"
 #include "version.h"
 
 #include "protobuf.h"
@@ -11,9 +10,8 @@ void send_msg_Success(int iface)
 {
     // response: Success message (id 2), payload len 0
     PB_CTX ctx;
-    pb_start(&ctx, 2);
+    pb_start(&ctx, iface, 2, 0);
     pb_end(&ctx);
-    usb_hid_write_blocking(iface, ctx.buf, ctx.pos, 1);
 }
 
 void send_msg_Failure(int iface)
@@ -21,15 +19,24 @@ void send_msg_Failure(int iface)
     // response: Failure message (id 3), payload len 2
     //           - code = 99 (Failure_FirmwareError)
     PB_CTX ctx;
-    pb_start(&ctx, 3);
+    pb_start(&ctx, iface, 3, 2);
     pb_add_varint(&ctx, 1, 99);
     pb_end(&ctx);
-    usb_hid_write_blocking(iface, ctx.buf, ctx.pos, 1);
+}
+
+static void encode_Features(PB_CTX *ctx, bool firmware_present)
+{
+    pb_add_string(ctx, 1, "trezor.io");
+    pb_add_varint(ctx, 2, VERSION_MAJOR);
+    pb_add_varint(ctx, 3, VERSION_MINOR);
+    pb_add_varint(ctx, 4, VERSION_PATCH);
+    pb_add_bool(ctx, 5, true);
+    pb_add_bool(ctx, 18, firmware_present);
 }
 
 void send_msg_Features(int iface, bool firmware_present)
 {
-    // response: Features message (id 17), payload len 22
+    // response: Features message (id 17), payload len measured first
     //           - vendor = "trezor.io"
     //           - major_version = VERSION_MAJOR
     //           - minor_version = VERSION_MINOR
@@ -37,26 +44,28 @@ void send_msg_Features(int iface, bool firmware_present)
     //           - bootloader_mode = True
     //           - firmware_present = True/False
     PB_CTX ctx;
-    pb_start(&ctx, 17);
-    pb_add_string(&ctx, 1, "trezor.io");
-    pb_add_varint(&ctx, 2, VERSION_MAJOR);
-    pb_add_varint(&ctx, 3, VERSION_MINOR);
-    pb_add_varint(&ctx, 4, VERSION_PATCH);
-    pb_add_bool(&ctx, 5, true);
-    pb_add_bool(&ctx, 18, firmware_present);
+    pb_measure(&ctx);
+    encode_Features(&ctx, firmware_present);
+    pb_start(&ctx, iface, 17, ctx.len);
+    encode_Features(&ctx, firmware_present);
     pb_end(&ctx);
-    usb_hid_write_blocking(iface, ctx.buf, ctx.pos, 1);
+}
+
+static void encode_FirmwareRequest(PB_CTX *ctx, uint32_t offset, uint32_t length)
+{
+    pb_add_varint(ctx, 1, offset);
+    pb_add_varint(ctx, 2, length);
 }
 
 void send_msg_FirmwareRequest(int iface, uint32_t offset, uint32_t length)
 {
-    // response: FirmwareRequest message (id 8), payload len X
+    // response: FirmwareRequest message (id 8), payload len measured first
     //           - offset = offset
     //           - length = length
     PB_CTX ctx;
-    pb_start(&ctx, 8);
-    pb_add_varint(&ctx, 1, offset);
-    pb_add_varint(&ctx, 2, length);
+    pb_measure(&ctx);
+    encode_FirmwareRequest(&ctx, offset, length);
+    pb_start(&ctx, iface, 8, ctx.len);
+    encode_FirmwareRequest(&ctx, offset, length);
     pb_end(&ctx);
-    usb_hid_write_blocking(iface, ctx.buf, ctx.pos, 1);
 }
@@ -1,37 +1,74 @@
+#include STM32_HAL_H
+
 #include <string.h>
+
+#include "usb.h"
+
 #include "protobuf.h"
 
-void pb_start(PB_CTX *ctx, uint16_t msg_id)
+// time to wait for the previous report to be picked up by the host (ms)
+#define PB_WRITE_TIMEOUT 10
+
+void pb_measure(PB_CTX *ctx)
 {
-    memset(ctx->buf, 0, sizeof(ctx->buf));
-    ctx->buf[0] = '?';
-    ctx->buf[1] = '#';
-    ctx->buf[2] = '#';
-    ctx->buf[3] = (msg_id >> 8) & 0xFF;
-    ctx->buf[4] = msg_id & 0xFF;
+    ctx->iface = -1;
+    ctx->len = 0;
+}
+
+void pb_start(PB_CTX *ctx, int iface, uint16_t msg_id, uint32_t msg_len)
+{
+    ctx->iface = iface;
+    ctx->idx = 0;
+    uint8_t *buf = ctx->buf[0];
+    buf[0] = '?';
+    buf[1] = '#';
+    buf[2] = '#';
+    buf[3] = (msg_id >> 8) & 0xFF;
+    buf[4] = msg_id & 0xFF;
+    buf[5] = (msg_len >> 24) & 0xFF;
+    buf[6] = (msg_len >> 16) & 0xFF;
+    buf[7] = (msg_len >> 8) & 0xFF;
+    buf[8] = msg_len & 0xFF;
     ctx->pos = 9;
     ctx->len = 0;
 }
 
+static void pb_flush(PB_CTX *ctx)
+{
+    usb_hid_write_blocking(ctx->iface, ctx->buf[ctx->idx], PB_REPORT_SIZE, PB_WRITE_TIMEOUT);
+    ctx->idx ^= 1;
+    ctx->buf[ctx->idx][0] = '?';
+    ctx->pos = 1;
+}
+
 void pb_end(PB_CTX *ctx)
 {
-    ctx->buf[5] = (ctx->len >> 24) & 0xFF;
-    ctx->buf[6] = (ctx->len >> 16) & 0xFF;
-    ctx->buf[7] = (ctx->len >> 8) & 0xFF;
-    ctx->buf[8] = ctx->len & 0xFF;
-    // align to 64 bytes
-    ctx->pos += (-ctx->pos) & 63;
+    if (ctx->iface < 0) {
+        return;
+    }
+    // send the last report padded with zeroes, unless it is empty
+    if (ctx->pos > 1) {
+        memset(ctx->buf[ctx->idx] + ctx->pos, 0, PB_REPORT_SIZE - ctx->pos);
+        pb_flush(ctx);
+    }
+    // the buffers must stay valid until the transmission is over
+    const uint32_t start = HAL_GetTick();
+    while (!usb_hid_can_write(ctx->iface) && HAL_GetTick() - start < PB_WRITE_TIMEOUT) {
+        __WFI();
+    }
 }
 
 inline static void pb_append(PB_CTX *ctx, uint8_t b)
 {
-    ctx->buf[ctx->pos] = b;
+    ctx->len++;
+    if (ctx->iface < 0) {
+        return;
+    }
+    ctx->buf[ctx->idx][ctx->pos] = b;
     ctx->pos++;
-    if (ctx->pos % 64 == 0) {
-        ctx->buf[ctx->pos] = '?';
-        ctx->pos++;
+    if (ctx->pos == PB_REPORT_SIZE) {
+        pb_flush(ctx);
     }
-    ctx->len++;
 }
 
 static void pb_varint(PB_CTX *ctx, uint32_t val)
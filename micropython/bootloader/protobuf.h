@@ -4,13 +4,24 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#define PB_REPORT_SIZE 64
+
+// messages are written to USB one report at a time, the report being
+// filled alternates between the two buffers because the previous one
+// might still be in transmission
 typedef struct {
-    uint8_t buf[128];
+    int iface;   // -1 if the message is only being measured
+    uint8_t buf[2][PB_REPORT_SIZE];
+    uint8_t idx;
     uint32_t pos;
     uint32_t len;
 } PB_CTX;
 
-void pb_start(PB_CTX *ctx, uint16_t msg_id);
+// first pass, only computes the payload length into ctx->len
+void pb_measure(PB_CTX *ctx);
+
+// second pass, msg_len is the payload length known up front or measured
+void pb_start(PB_CTX *ctx, int iface, uint16_t msg_id, uint32_t msg_len);
 void pb_end(PB_CTX *ctx);
 
 void pb_add_bool(PB_CTX *ctx, uint32_t field_number, bool val);
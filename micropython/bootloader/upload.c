@@ -0,0 +1,222 @@
+#include <string.h>
+
+#include "common.h"
+#include "flash.h"
+#include "image.h"
+
+#include "upload.h"
+
+// incoming data is collected into one buffer while the other one is
+// being programmed, so the USB endpoint is never blocked by the flash
+#define UPLOAD_BUFFER_SIZE 1024
+
+// number of words programmed by a single upload_poll() call (~1 ms)
+#define UPLOAD_POLL_WORDS 64
+
+static struct {
+    uint32_t buf[2][UPLOAD_BUFFER_SIZE / sizeof(uint32_t)];
+    uint8_t fill_idx;       // buffer being filled from USB
+    uint32_t fill_len;      // bytes in the buffer being filled
+    bool pending;           // the other buffer waits to be programmed
+    uint32_t pending_len;   // bytes in the pending buffer
+    uint32_t pending_pos;   // bytes of the pending buffer already programmed
+    uint32_t received;      // bytes received so far
+    uint32_t written;       // bytes programmed so far
+    uint32_t hashed;        // bytes hashed so far
+    int erased;             // last erased sector
+    uint32_t vhdrlen;       // taken from the stream, 0 if not received yet
+    uint32_t codelen;       // taken from the stream, 0 if not received yet
+    bool parsed;            // headers were parsed from the flash
+    bool failed;
+    vendor_header vhdr;
+    image_header hdr;
+    image_hash_ctx hash;
+} upload;
+
+// copies bytes of the 32-bit value at offset "at" of the upload out of
+// the chunk which starts at offset "pos"
+static void capture_u32(const uint8_t *data, uint32_t pos, uint32_t len, uint32_t at, uint32_t *val)
+{
+    for (uint32_t i = 0; i < 4; i++) {
+        if (at + i >= pos && at + i < pos + len) {
+            ((uint8_t *)val)[i] = data[at + i - pos];
+        }
+    }
+}
+
+static bool fail(void)
+{
+    upload.failed = true;
+    upload.pending = false;
+    flash_lock();
+    return false;
+}
+
+void upload_start(void)
+{
+    memset(&upload, 0, sizeof(upload));
+    upload.erased = flash_sector_of(FIRMWARE_START) - 1;
+    flash_unlock();
+}
+
+uint32_t upload_received(void)
+{
+    return upload.received;
+}
+
+uint32_t upload_total(void)
+{
+    // the lengths can arrive split across writes, they are known only once
+    // all their bytes have been captured (vhdrlen at 4, codelen at vhdrlen + 12)
+    if (upload.received < 16 || upload.received - 16 < upload.vhdrlen) {
+        return 0;
+    }
+    if (upload.vhdrlen == 0 || upload.codelen == 0 || upload.vhdrlen > IMAGE_MAXSIZE || upload.codelen > IMAGE_MAXSIZE) {
+        return 0;
+    }
+    return upload.vhdrlen + HEADER_SIZE + upload.codelen;
+}
+
+// parses the headers once they are in the flash and hashes everything
+// programmed since the last call, so the hash is done with the last word
+static bool process_written(void)
+{
+    const uint8_t *fw = (const uint8_t *)FIRMWARE_START;
+    if (!upload.parsed) {
+        if (upload_total() == 0 || upload.written < upload.vhdrlen + HEADER_SIZE) {
+            return true;
+        }
+        if (!vendor_parse_header(fw, &upload.vhdr)) {
+            return false;
+        }
+        if (!vendor_check_signature(fw, &upload.vhdr)) {
+            return false;
+        }
+        if (!image_parse_header(fw + upload.vhdr.hdrlen, IMAGE_MAGIC, IMAGE_MAXSIZE, &upload.hdr)) {
+            return false;
+        }
+        if (upload.vhdr.hdrlen + upload.hdr.hdrlen + upload.hdr.codelen != upload_total()) {
+            return false;
+        }
+        image_hash_init(&upload.hash, HEADER_SIZE);
+        upload.hashed = upload.vhdr.hdrlen;
+        upload.parsed = true;
+    }
+    uint32_t end = upload.written < upload_total() ? upload.written : upload_total();
+    if (end > upload.hashed) {
+        image_hash_update(&upload.hash, fw + upload.hashed, end - upload.hashed);
+        upload.hashed = end;
+    }
+    return true;
+}
+
+static bool program_words(uint32_t count)
+{
+    const uint32_t *buf = upload.buf[upload.fill_idx ^ 1];
+    while (upload.pending && count > 0) {
+        uint32_t addr = FIRMWARE_START + upload.written;
+        // erase sectors only when the write pointer enters them
+        int sector = flash_sector_of(addr);
+        if (sector < 0) {
+            return false;
+        }
+        if (sector > upload.erased) {
+            if (!flash_erase_sector(sector)) {
+                return false;
+            }
+            upload.erased = sector;
+        }
+        if (!flash_write_word(addr, buf[upload.pending_pos / sizeof(uint32_t)])) {
+            return false;
+        }
+        upload.pending_pos += sizeof(uint32_t);
+        upload.written += sizeof(uint32_t);
+        count--;
+        if (upload.pending_pos >= upload.pending_len) {
+            upload.pending = false;
+            return process_written();
+        }
+    }
+    return true;
+}
+
+static bool swap_buffers(void)
+{
+    // the other buffer has to be programmed before it can be filled again
+    if (!program_words(UINT32_MAX)) {
+        return false;
+    }
+    upload.pending = true;
+    upload.pending_len = upload.fill_len;
+    upload.pending_pos = 0;
+    upload.fill_idx ^= 1;
+    upload.fill_len = 0;
+    return true;
+}
+
+bool upload_write(const uint8_t *data, uint32_t len)
+{
+    if (upload.failed) {
+        return false;
+    }
+    if (upload.received + len > IMAGE_MAXSIZE) {
+        return fail();
+    }
+    if (upload_total() == 0) {
+        capture_u32(data, upload.received, len, 4, &upload.vhdrlen);
+        if (upload.received + len >= 8 && upload.vhdrlen <= IMAGE_MAXSIZE) {
+            capture_u32(data, upload.received, len, upload.vhdrlen + 12, &upload.codelen);
+        }
+    }
+    upload.received += len;
+    while (len > 0) {
+        uint32_t n = UPLOAD_BUFFER_SIZE - upload.fill_len;
+        if (n > len) n = len;
+        memcpy((uint8_t *)upload.buf[upload.fill_idx] + upload.fill_len, data, n);
+        upload.fill_len += n;
+        data += n;
+        len -= n;
+        if (upload.fill_len == UPLOAD_BUFFER_SIZE && !swap_buffers()) {
+            return fail();
+        }
+    }
+    return true;
+}
+
+bool upload_poll(void)
+{
+    if (upload.failed) {
+        return false;
+    }
+    if (!program_words(UPLOAD_POLL_WORDS)) {
+        return fail();
+    }
+    return true;
+}
+
+bool upload_finish(void)
+{
+    if (upload.failed) {
+        return false;
+    }
+    if (upload_total() == 0 || upload.received != upload_total()) {
+        return fail();
+    }
+    // pad the last buffer to whole words
+    while (upload.fill_len % sizeof(uint32_t) != 0) {
+        ((uint8_t *)upload.buf[upload.fill_idx])[upload.fill_len++] = 0xFF;
+    }
+    if (upload.fill_len > 0 && !swap_buffers()) {
+        return fail();
+    }
+    if (!program_words(UINT32_MAX)) {
+        return fail();
+    }
+    flash_lock();
+    if (!upload.parsed || upload.hashed != upload_total()) {
+        return false;
+    }
+    uint8_t hash[BLAKE2S_DIGEST_LENGTH];
+    image_hash_final(&upload.hash, hash);
+    return image_check_hash(hash, &upload.hdr, &upload.vhdr);
+}
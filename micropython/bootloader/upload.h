@@ -0,0 +1,29 @@
+#ifndef __UPLOAD_H__
+#define __UPLOAD_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define IMAGE_MAGIC   0x465A5254 // TRZF
+#define IMAGE_MAXSIZE (7 * 128 * 1024)
+
+// size of one FirmwareRequest chunk
+#define UPLOAD_CHUNK_SIZE (128 * 1024)
+
+void upload_start(void);
+
+// buffers the data, programs the previous buffer only if it is still pending
+bool upload_write(const uint8_t *data, uint32_t len);
+
+// programs a few words of the pending buffer, call when USB is idle
+bool upload_poll(void);
+
+// programs the rest of the data and checks the firmware signature
+bool upload_finish(void);
+
+uint32_t upload_received(void);
+
+// size of the whole upload, 0 until both headers have been received
+uint32_t upload_total(void);
+
+#endif
@@ -20,6 +20,30 @@ STATIC const mp_obj_type_t mod_TrezorCrypto_HDNode_type;
 #define XPUB_MAXLEN 128
 #define ADDRESS_MAXLEN 36
 
+#define ROOT_CACHE_SIZE 4
+
+typedef struct _root_cache_item_t {
+    bool set;
+    HDNode hdnode;
+} root_cache_item_t;
+
+// Seed and per-curve root nodes of the unlocked wallet.  Kept in static RAM
+// outside of the GC heap, so they outlive module unimports between workflows.
+STATIC struct {
+    uint8_t seed[64];
+    size_t seed_len;
+    root_cache_item_t roots[ROOT_CACHE_SIZE];
+    int next;
+} root_cache;
+
+STATIC void root_cache_clear(void) {
+    // volatile pointer keeps the compiler from eliding the wipe
+    volatile uint8_t *p = (volatile uint8_t *)&root_cache;
+    for (size_t i = 0; i < sizeof(root_cache); i++) {
+        p[i] = 0;
+    }
+}
+
 /// def trezor.crypto.HDNode.derive(index: int) -> None:
 ///     '''
 ///     Derive a BIP0032 child node in place.
@@ -295,9 +319,86 @@ STATIC mp_obj_t mod_TrezorCrypto_Bip32_from_seed(mp_obj_t self, mp_obj_t seed, m
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_TrezorCrypto_Bip32_from_seed_obj, mod_TrezorCrypto_Bip32_from_seed);
 
+/// def trezor.crypto.bip32.cache_seed(seed: bytes) -> None:
+///     '''
+///     Store a BIP0039 seed in the root node cache, dropping all root nodes
+///     cached for the previous seed.
+///     '''
+STATIC mp_obj_t mod_TrezorCrypto_Bip32_cache_seed(mp_obj_t self, mp_obj_t seed) {
+    mp_buffer_info_t seedb;
+    mp_get_buffer_raise(seed, &seedb, MP_BUFFER_READ);
+    if (seedb.len == 0 || seedb.len > sizeof(root_cache.seed)) {
+        mp_raise_ValueError("Invalid seed");
+    }
+    root_cache_clear();
+    memcpy(root_cache.seed, seedb.buf, seedb.len);
+    root_cache.seed_len = seedb.len;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorCrypto_Bip32_cache_seed_obj, mod_TrezorCrypto_Bip32_cache_seed);
+
+/// def trezor.crypto.bip32.cached_root(curve_name: str) -> HDNode:
+///     '''
+///     Return a copy of the root node for the cached seed and given curve, or
+///     None if no seed is cached.  Root nodes are derived once per curve.
+///     '''
+STATIC mp_obj_t mod_TrezorCrypto_Bip32_cached_root(mp_obj_t self, mp_obj_t curve_name) {
+    mp_buffer_info_t curveb;
+    mp_get_buffer_raise(curve_name, &curveb, MP_BUFFER_READ);
+    if (curveb.len == 0) {
+        mp_raise_ValueError("Invalid curve name");
+    }
+    const curve_info *curve = get_curve_by_name(curveb.buf);
+    if (curve == NULL) {
+        mp_raise_ValueError("Invalid curve name");
+    }
+    if (root_cache.seed_len == 0) {
+        return mp_const_none;
+    }
+
+    // look up the curve, or derive the root node into the next slot
+    root_cache_item_t *item = NULL;
+    for (int i = 0; i < ROOT_CACHE_SIZE; i++) {
+        if (root_cache.roots[i].set && root_cache.roots[i].hdnode.curve == curve) {
+            item = &root_cache.roots[i];
+            break;
+        }
+    }
+    if (item == NULL) {
+        item = &root_cache.roots[root_cache.next];
+        root_cache.next = (root_cache.next + 1) % ROOT_CACHE_SIZE;
+        item->set = false;
+        if (!hdnode_from_seed(root_cache.seed, root_cache.seed_len, curveb.buf, &item->hdnode)) {
+            memset(&item->hdnode, 0, sizeof(item->hdnode));
+            mp_raise_ValueError("Failed to derive the root node");
+        }
+        item->set = true;
+    }
+
+    mp_obj_HDNode_t *o = m_new_obj(mp_obj_HDNode_t);
+    o->base.type = &mod_TrezorCrypto_HDNode_type;
+    o->hdnode = item->hdnode;
+    o->fingerprint = 0;
+    return MP_OBJ_FROM_PTR(o);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorCrypto_Bip32_cached_root_obj, mod_TrezorCrypto_Bip32_cached_root);
+
+/// def trezor.crypto.bip32.clear_cache() -> None:
+///     '''
+///     Wipe the cached seed and all cached root nodes.
+///     '''
+STATIC mp_obj_t mod_TrezorCrypto_Bip32_clear_cache(mp_obj_t self) {
+    root_cache_clear();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorCrypto_Bip32_clear_cache_obj, mod_TrezorCrypto_Bip32_clear_cache);
+
 STATIC const mp_rom_map_elem_t mod_TrezorCrypto_Bip32_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deserialize), MP_ROM_PTR(&mod_TrezorCrypto_Bip32_deserialize_obj) },
     { MP_ROM_QSTR(MP_QSTR_from_seed), MP_ROM_PTR(&mod_TrezorCrypto_Bip32_from_seed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cache_seed), MP_ROM_PTR(&mod_TrezorCrypto_Bip32_cache_seed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cached_root), MP_ROM_PTR(&mod_TrezorCrypto_Bip32_cached_root_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear_cache), MP_ROM_PTR(&mod_TrezorCrypto_Bip32_clear_cache_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(mod_TrezorCrypto_Bip32_locals_dict, mod_TrezorCrypto_Bip32_locals_dict_table);
 
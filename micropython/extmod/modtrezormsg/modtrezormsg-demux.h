@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) Pavol Rusnak, Jan Pochyla, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#include "py/objarray.h"
+
+// wire protocol #2 (see src/trezor/wire/codec_v2.py) reports are parsed here,
+// message data is reassembled into per-session buffers and checksummed, so
+// python sees whole messages (or buffer-sized chunks of the large ones)
+// instead of every report
+
+#define DEMUX_SESSIONS    16
+#define DEMUX_REPORT_LEN  64
+#define DEMUX_PAYLOAD_LEN (DEMUX_REPORT_LEN - 5)  // marker, session id
+#define DEMUX_HEADER_LEN  8                       // msg type, data length
+#define DEMUX_FOOTER_LEN  4                       // data crc32
+
+#define DEMUX_MARKER_HEADER 'H'
+#define DEMUX_MARKER_DATA   'D'
+#define DEMUX_MARKER_OPEN   'O'
+#define DEMUX_MARKER_CLOSE  'C'
+
+enum {
+    DEMUX_OPEN = 0,      // request for a new session
+    DEMUX_CLOSE = 1,     // request for closing the session
+    DEMUX_UNKNOWN = 2,   // report on a session that is not opened
+    DEMUX_CHUNK = 3,     // part of message data, more chunks follow
+    DEMUX_MESSAGE = 4,   // last chunk of message data, checksum is valid
+    DEMUX_CHECKSUM = 5,  // last chunk of message data, checksum is invalid
+};
+
+enum {
+    DEMUX_IDLE = 0,    // waiting for message header
+    DEMUX_DATA = 1,    // reading message data
+    DEMUX_FOOTER = 2,  // reading message checksum
+};
+
+extern uint32_t uzlib_crc32(const void *data, unsigned int length, uint32_t crc); // defined in extmod/uzlib
+
+typedef struct {
+    uint32_t session_id;
+    uint8_t *buf;       // allocated on first message
+    uint32_t buf_pos;
+    uint32_t msg_type;
+    uint32_t msg_len;
+    uint32_t msg_pos;
+    uint32_t crc;       // of msg_pos - buf_pos bytes handed out in chunks
+    uint8_t footer[DEMUX_FOOTER_LEN];
+    uint8_t footer_len;
+    uint8_t state;
+    bool used;
+} demux_session_t;
+
+typedef struct _mp_obj_Demux_t {
+    mp_obj_base_t base;
+    size_t buf_len;
+    demux_session_t sessions[DEMUX_SESSIONS];
+} mp_obj_Demux_t;
+
+static uint32_t demux_read_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static demux_session_t *demux_find(mp_obj_Demux_t *o, uint32_t session_id) {
+    for (int i = 0; i < DEMUX_SESSIONS; i++) {
+        if (o->sessions[i].used && o->sessions[i].session_id == session_id) {
+            return &o->sessions[i];
+        }
+    }
+    return NULL;
+}
+
+STATIC mp_obj_t demux_event(mp_int_t event, uint32_t session_id, const demux_session_t *s, uint32_t offset, mp_obj_t chunk) {
+    mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(6, NULL));
+    tuple->items[0] = MP_OBJ_NEW_SMALL_INT(event);
+    tuple->items[1] = mp_obj_new_int_from_uint(session_id);
+    tuple->items[2] = s ? mp_obj_new_int_from_uint(s->msg_type) : mp_const_none;
+    tuple->items[3] = s ? mp_obj_new_int_from_uint(s->msg_len) : mp_const_none;
+    tuple->items[4] = s ? mp_obj_new_int_from_uint(offset) : mp_const_none;
+    tuple->items[5] = chunk;
+    return MP_OBJ_FROM_PTR(tuple);
+}
+
+// hands out the buffered data, the chunk is valid until the next feed().
+// zero offset of the chunk in message data marks the start of a message
+STATIC mp_obj_t demux_flush(demux_session_t *s, mp_int_t event) {
+    mp_obj_t chunk = mp_obj_new_memoryview('B', s->buf_pos, s->buf);
+    const uint32_t offset = s->msg_pos - s->buf_pos;
+    s->crc = uzlib_crc32(s->buf, s->buf_pos, s->crc);
+    s->buf_pos = 0;
+    if (event != DEMUX_CHUNK) {
+        const uint32_t checksum = s->crc ^ 0xFFFFFFFF;
+        if (checksum != demux_read_be32(s->footer)) {
+            event = DEMUX_CHECKSUM;
+        }
+        s->state = DEMUX_IDLE;
+    }
+    return demux_event(event, s->session_id, s, offset, chunk);
+}
+
+STATIC mp_obj_t mod_TrezorMsg_Demux_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    const mp_int_t buf_len = mp_obj_get_int(args[0]);
+    if (buf_len < DEMUX_PAYLOAD_LEN) {
+        mp_raise_ValueError("Buffer too small");
+    }
+    mp_obj_Demux_t *o = m_new0(mp_obj_Demux_t, 1);
+    o->base.type = type;
+    o->buf_len = buf_len;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+/// def trezor.msg.Demux.open(self, session_id: int) -> None:
+///     '''
+///     Starts reassembling messages of the session.
+///     '''
+STATIC mp_obj_t mod_TrezorMsg_Demux_open(mp_obj_t self, mp_obj_t session_id) {
+    mp_obj_Demux_t *o = MP_OBJ_TO_PTR(self);
+    const uint32_t sid = mp_obj_get_int_truncated(session_id);
+    if (demux_find(o, sid) != NULL) {
+        return mp_const_none;
+    }
+    for (int i = 0; i < DEMUX_SESSIONS; i++) {
+        demux_session_t *s = &o->sessions[i];
+        if (!s->used) {
+            memset(s, 0, sizeof(demux_session_t));
+            s->session_id = sid;
+            s->used = true;
+            return mp_const_none;
+        }
+    }
+    mp_raise_msg(&mp_type_RuntimeError, "Too many sessions");
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorMsg_Demux_open_obj, mod_TrezorMsg_Demux_open);
+
+/// def trezor.msg.Demux.close(self, session_id: int) -> None:
+///     '''
+///     Stops reassembling messages of the session, drops its buffer.
+///     '''
+STATIC mp_obj_t mod_TrezorMsg_Demux_close(mp_obj_t self, mp_obj_t session_id) {
+    mp_obj_Demux_t *o = MP_OBJ_TO_PTR(self);
+    demux_session_t *s = demux_find(o, mp_obj_get_int_truncated(session_id));
+    if (s != NULL) {
+        if (s->buf != NULL) {
+            m_del(uint8_t, s->buf, o->buf_len);
+        }
+        memset(s, 0, sizeof(demux_session_t));
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorMsg_Demux_close_obj, mod_TrezorMsg_Demux_close);
+
+/// def trezor.msg.Demux.feed(self, report: bytes) -> tuple:
+///     '''
+///     Processes a wire v2 report.  Returns None if the report was consumed,
+///     otherwise a tuple (event, session_id, msg_type, data_len, offset, chunk),
+///     where chunk is a memoryview of message data, valid until the next call,
+///     and offset is its position in the message data (zero for the first).
+///     '''
+STATIC mp_obj_t mod_TrezorMsg_Demux_feed(mp_obj_t self, mp_obj_t report) {
+    mp_obj_Demux_t *o = MP_OBJ_TO_PTR(self);
+    mp_buffer_info_t rep;
+    mp_get_buffer_raise(report, &rep, MP_BUFFER_READ);
+    if (rep.len != DEMUX_REPORT_LEN) {
+        mp_raise_ValueError("Invalid buffer size");
+    }
+    const uint8_t *p = rep.buf;
+    const uint8_t marker = p[0];
+    const uint32_t sid = demux_read_be32(p + 1);
+    p += DEMUX_REPORT_LEN - DEMUX_PAYLOAD_LEN;
+    size_t n = DEMUX_PAYLOAD_LEN;
+
+    if (marker == DEMUX_MARKER_OPEN) {
+        return demux_event(DEMUX_OPEN, sid, NULL, 0, mp_const_none);
+    }
+    if (marker == DEMUX_MARKER_CLOSE) {
+        return demux_event(DEMUX_CLOSE, sid, NULL, 0, mp_const_none);
+    }
+    demux_session_t *s = demux_find(o, sid);
+    if (s == NULL) {
+        return demux_event(DEMUX_UNKNOWN, sid, NULL, 0, mp_const_none);
+    }
+
+    if (marker == DEMUX_MARKER_HEADER) {
+        if (s->buf == NULL) {
+            s->buf = m_new(uint8_t, o->buf_len);
+        }
+        s->msg_type = demux_read_be32(p);
+        s->msg_len = demux_read_be32(p + 4);
+        s->msg_pos = 0;
+        s->buf_pos = 0;
+        s->crc = 0xFFFFFFFF;
+        s->footer_len = 0;
+        s->state = DEMUX_DATA;
+        p += DEMUX_HEADER_LEN;
+        n -= DEMUX_HEADER_LEN;
+    } else if (marker != DEMUX_MARKER_DATA || s->state == DEMUX_IDLE) {
+        return mp_const_none;  // not in a message, drop it
+    }
+
+    if (s->state == DEMUX_DATA) {
+        size_t take = s->msg_len - s->msg_pos;
+        if (take > n) {
+            take = n;
+        }
+        // the buffer is flushed while it still has room for a full
+        // payload, see below
+        memcpy(s->buf + s->buf_pos, p, take);
+        s->buf_pos += take;
+        s->msg_pos += take;
+        p += take;
+        n -= take;
+        if (s->msg_pos == s->msg_len) {
+            s->state = DEMUX_FOOTER;
+        }
+    }
+    if (s->state == DEMUX_FOOTER) {
+        size_t take = DEMUX_FOOTER_LEN - s->footer_len;
+        if (take > n) {
+            take = n;
+        }
+        memcpy(s->footer + s->footer_len, p, take);
+        s->footer_len += take;
+        if (s->footer_len == DEMUX_FOOTER_LEN) {
+            return demux_flush(s, DEMUX_MESSAGE);
+        }
+    } else if (o->buf_len - s->buf_pos < DEMUX_PAYLOAD_LEN) {
+        return demux_flush(s, DEMUX_CHUNK);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorMsg_Demux_feed_obj, mod_TrezorMsg_Demux_feed);
+
+STATIC const mp_rom_map_elem_t mod_TrezorMsg_Demux_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_open), MP_ROM_PTR(&mod_TrezorMsg_Demux_open_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mod_TrezorMsg_Demux_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_feed), MP_ROM_PTR(&mod_TrezorMsg_Demux_feed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_OPEN), MP_OBJ_NEW_SMALL_INT(DEMUX_OPEN) },
+    { MP_ROM_QSTR(MP_QSTR_CLOSE), MP_OBJ_NEW_SMALL_INT(DEMUX_CLOSE) },
+    { MP_ROM_QSTR(MP_QSTR_UNKNOWN), MP_OBJ_NEW_SMALL_INT(DEMUX_UNKNOWN) },
+    { MP_ROM_QSTR(MP_QSTR_CHUNK), MP_OBJ_NEW_SMALL_INT(DEMUX_CHUNK) },
+    { MP_ROM_QSTR(MP_QSTR_MESSAGE), MP_OBJ_NEW_SMALL_INT(DEMUX_MESSAGE) },
+    { MP_ROM_QSTR(MP_QSTR_CHECKSUM), MP_OBJ_NEW_SMALL_INT(DEMUX_CHECKSUM) },
+};
+STATIC MP_DEFINE_CONST_DICT(mod_TrezorMsg_Demux_locals_dict, mod_TrezorMsg_Demux_locals_dict_table);
+
+STATIC const mp_obj_type_t mod_TrezorMsg_Demux_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Demux,
+    .make_new = mod_TrezorMsg_Demux_make_new,
+    .locals_dict = (void*)&mod_TrezorMsg_Demux_locals_dict,
+};
@@ -24,6 +24,12 @@
 #error Unsupported TREZOR port. Only STM32 and UNIX ports are supported.
 #endif
 
+#if MICROPY_PY_TREZORTELEMETRY
+#include "../modtrezortelemetry/telemetry.h"
+#endif
+
+#include "modtrezormsg-demux.h"
+
 typedef struct _mp_obj_USB_t {
     mp_obj_base_t base;
     usb_dev_info_t info;
@@ -369,6 +375,9 @@ STATIC mp_obj_t mod_TrezorMsg_Msg_send(mp_obj_t self, mp_obj_t iface, mp_obj_t m
     mp_buffer_info_t msg;
     mp_get_buffer_raise(message, &msg, MP_BUFFER_READ);
     ssize_t r = msg_send(i, msg.buf, msg.len);
+#if MICROPY_PY_TREZORTELEMETRY
+    telemetry_counters[TELEMETRY_REPORT_TX]++;
+#endif
     return MP_OBJ_NEW_SMALL_INT(r);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_TrezorMsg_Msg_send_obj, mod_TrezorMsg_Msg_send);
@@ -402,6 +411,9 @@ STATIC mp_obj_t mod_TrezorMsg_Msg_select(mp_obj_t self, mp_obj_t timeout_us) {
         uint8_t recvbuf[64];
         ssize_t l = msg_recv(&iface, recvbuf, 64);
         if (l > 0) {
+#if MICROPY_PY_TREZORTELEMETRY
+            telemetry_counters[TELEMETRY_REPORT_RX]++;
+#endif
             if (l == 8 && memcmp("PINGPING", recvbuf, 8) == 0) {
                 msg_send(iface, (const uint8_t *)"PONGPONG", 8);
                 return mp_const_none;
@@ -454,6 +466,7 @@ STATIC const mp_rom_map_elem_t mp_module_TrezorMsg_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_HID), MP_ROM_PTR(&mod_TrezorMsg_HID_type) },
     { MP_ROM_QSTR(MP_QSTR_VCP), MP_ROM_PTR(&mod_TrezorMsg_VCP_type) },
     { MP_ROM_QSTR(MP_QSTR_Msg), MP_ROM_PTR(&mod_TrezorMsg_Msg_type) },
+    { MP_ROM_QSTR(MP_QSTR_Demux), MP_ROM_PTR(&mod_TrezorMsg_Demux_type) },
 };
 STATIC MP_DEFINE_CONST_DICT(mp_module_TrezorMsg_globals, mp_module_TrezorMsg_globals_table);
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Jan Pochyla, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#include <string.h>
+
+#include "py/runtime.h"
+
+#if MICROPY_PY_TREZORRES
+
+// resource pack generated by tools/res_collect, laid out as
+//   uint32_t count
+//   struct { uint32_t hash, offset, length; } index[count] (sorted by hash)
+//   data
+#if __has_include("resources.h")
+#include "resources.h"
+#else
+// no resources collected yet, everything is loaded from files
+static const uint32_t resources_pack[] = { 0 };
+#endif
+
+// FNV-1a, has to match tools/res_collect
+static uint32_t res_hash(const uint8_t *data, size_t len) {
+    uint32_t h = 0x811C9DC5;
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 0x01000193;
+    }
+    return h;
+}
+
+/// def trezor.res.hash(name: str) -> int:
+///     '''
+///     Returns the hash of the resource name, as used by the resource pack.
+///     '''
+STATIC mp_obj_t mod_TrezorRes_hash(mp_obj_t name) {
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(name, &buf, MP_BUFFER_READ);
+    return mp_obj_new_int_from_uint(res_hash(buf.buf, buf.len));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorRes_hash_obj, mod_TrezorRes_hash);
+
+/// def trezor.res.get(name_hash: int) -> memoryview:
+///     '''
+///     Returns a read-only view of the resource stored in the resource pack
+///     or None if there is no resource with this name hash.
+///     '''
+STATIC mp_obj_t mod_TrezorRes_get(mp_obj_t name_hash) {
+    const uint32_t h = mp_obj_get_int_truncated(name_hash);
+    const uint32_t *index = resources_pack + 1;
+    // binary search in the sorted index
+    uint32_t lo = 0, hi = resources_pack[0];
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const uint32_t *e = index + mid * 3;
+        if (e[0] < h) {
+            lo = mid + 1;
+        } else if (e[0] > h) {
+            hi = mid;
+        } else {
+            return mp_obj_new_memoryview('B', e[2], (uint8_t *)resources_pack + e[1]);
+        }
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorRes_get_obj, mod_TrezorRes_get);
+
+STATIC const mp_rom_map_elem_t mp_module_TrezorRes_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_TrezorRes) },
+    { MP_ROM_QSTR(MP_QSTR_hash), MP_ROM_PTR(&mod_TrezorRes_hash_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&mod_TrezorRes_get_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_module_TrezorRes_globals, mp_module_TrezorRes_globals_table);
+
+const mp_obj_module_t mp_module_TrezorRes = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&mp_module_TrezorRes_globals,
+};
+
+#endif // MICROPY_PY_TREZORRES
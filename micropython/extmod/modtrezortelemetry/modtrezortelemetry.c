@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) Pavol Rusnak, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "py/gc.h"
+#include "py/objstr.h"
+
+#if MICROPY_PY_TREZORTELEMETRY
+
+#include "telemetry.h"
+
+#if MICROPY_PY_TREZORUI
+#include "../modtrezorui/display.h"
+#endif
+
+#if defined TREZOR_UNIX
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define TELEMETRY_UDP_PORT 21326
+#endif
+
+// histograms of durations in microseconds
+
+#define HIST_STEP        0  // task step
+#define HIST_GC          1  // garbage collection pause
+#define HIST_WAIT_SLEEP  2  // task waiting in a syscall, by the syscall
+#define HIST_WAIT_SELECT 3
+#define HIST_WAIT_SIGNAL 4
+#define HIST_WAIT_WAIT   5
+
+#define HIST_COUNT       6
+
+// bucket i holds durations in [2^i, 2^(i+1)) us, first bucket also 0,
+// the last bucket is open-ended
+#define HIST_BUCKETS     16
+
+typedef struct {
+    uint32_t count;
+    uint32_t total; // wraps around, use differences between snapshots
+    uint32_t max;
+    uint32_t buckets[HIST_BUCKETS];
+} histogram_t;
+
+// snapshot layout, all fields are little-endian uint32
+typedef struct {
+    uint32_t magic;
+    uint32_t report_rx;
+    uint32_t report_tx;
+    uint32_t display_bytes;
+    uint32_t waits_dropped;
+    histogram_t hist[HIST_COUNT];
+} telemetry_t;
+
+#define TELEMETRY_MAGIC 0x314D4C54 // TLM1
+
+uint32_t telemetry_counters[TELEMETRY_COUNTERS];
+
+static telemetry_t T;
+
+// tasks waiting in a syscall, keyed by the task object
+#define WAIT_SLOTS 16
+
+static struct {
+    const void *task;
+    uint32_t start;
+    int kind;
+} waits[WAIT_SLOTS];
+
+static void hist_record(int kind, uint32_t us) {
+    if (kind < 0 || kind >= HIST_COUNT) {
+        return;
+    }
+    histogram_t *h = &T.hist[kind];
+    h->count++;
+    h->total += us;
+    if (us > h->max) {
+        h->max = us;
+    }
+    int b = 0;
+    while (us > 1 && b < HIST_BUCKETS - 1) {
+        us >>= 1;
+        b++;
+    }
+    h->buckets[b]++;
+}
+
+/// def trezor.telemetry.record(histogram: int, us: int) -> None:
+///     '''
+///     Records duration us (in microseconds) into the histogram.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_record(mp_obj_t histogram, mp_obj_t us) {
+    hist_record(mp_obj_get_int(histogram), mp_obj_get_int_truncated(us));
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorTelemetry_record_obj, mod_TrezorTelemetry_record);
+
+/// def trezor.telemetry.task_resumed(task) -> int:
+///     '''
+///     Marks the start of a task step and returns the current time in microseconds.
+///     Records the time the task spent waiting in a syscall (see task_suspended).
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_task_resumed(mp_obj_t task) {
+    const uint32_t now = mp_hal_ticks_us();
+    const void *t = MP_OBJ_TO_PTR(task);
+    for (int i = 0; i < WAIT_SLOTS; i++) {
+        if (waits[i].task == t) {
+            hist_record(waits[i].kind, now - waits[i].start);
+            waits[i].task = NULL;
+            break;
+        }
+    }
+    return mp_obj_new_int_from_uint(now);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorTelemetry_task_resumed_obj, mod_TrezorTelemetry_task_resumed);
+
+/// def trezor.telemetry.task_suspended(task, start: int, wait: int) -> None:
+///     '''
+///     Records the duration of a task step started at start (see task_resumed).
+///     If wait is a WAIT_* histogram, time until the task is resumed is recorded into it.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_task_suspended(mp_obj_t task, mp_obj_t start, mp_obj_t wait) {
+    const uint32_t now = mp_hal_ticks_us();
+    hist_record(HIST_STEP, now - (uint32_t)mp_obj_get_int_truncated(start));
+    const int kind = mp_obj_get_int(wait);
+    if (kind < HIST_WAIT_SLEEP || kind >= HIST_COUNT) {
+        return mp_const_none;
+    }
+    // reuse a free slot or evict the oldest wait
+    int slot = 0;
+    for (int i = 0; i < WAIT_SLOTS; i++) {
+        if (waits[i].task == NULL) {
+            slot = i;
+            break;
+        }
+        if ((int32_t)(waits[i].start - waits[slot].start) < 0) {
+            slot = i;
+        }
+    }
+    if (waits[slot].task != NULL) {
+        T.waits_dropped++;
+    }
+    waits[slot].task = MP_OBJ_TO_PTR(task);
+    waits[slot].start = now;
+    waits[slot].kind = kind;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_TrezorTelemetry_task_suspended_obj, mod_TrezorTelemetry_task_suspended);
+
+/// def trezor.telemetry.collect() -> None:
+///     '''
+///     Runs garbage collection and records its pause.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_collect(void) {
+    const uint32_t start = mp_hal_ticks_us();
+    gc_collect();
+    hist_record(HIST_GC, mp_hal_ticks_us() - start);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_TrezorTelemetry_collect_obj, mod_TrezorTelemetry_collect);
+
+static void telemetry_update(void) {
+    T.magic = TELEMETRY_MAGIC;
+    T.report_rx = telemetry_counters[TELEMETRY_REPORT_RX];
+    T.report_tx = telemetry_counters[TELEMETRY_REPORT_TX];
+#if MICROPY_PY_TREZORUI
+    T.display_bytes = display_bytes_pushed();
+#endif
+}
+
+/// def trezor.telemetry.snapshot() -> bytes:
+///     '''
+///     Returns current counters and histograms, see tools/telemetry for the layout.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_snapshot(void) {
+    telemetry_update();
+    return mp_obj_new_bytes((const uint8_t *)&T, sizeof(T));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_TrezorTelemetry_snapshot_obj, mod_TrezorTelemetry_snapshot);
+
+/// def trezor.telemetry.reset() -> None:
+///     '''
+///     Clears all histograms.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_reset(void) {
+    memset(T.hist, 0, sizeof(T.hist));
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_TrezorTelemetry_reset_obj, mod_TrezorTelemetry_reset);
+
+/// def trezor.telemetry.publish() -> None:
+///     '''
+///     Sends the snapshot as a UDP datagram to TREZOR_TELEMETRY_PORT (emulator only).
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_publish(void) {
+#if defined TREZOR_UNIX
+    static int s = -1;
+    static struct sockaddr_in si;
+    if (s < 0) {
+        s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (s < 0) {
+            return mp_const_none;
+        }
+        si.sin_family = AF_INET;
+        si.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        const char *port = getenv("TREZOR_TELEMETRY_PORT");
+        si.sin_port = htons(port ? atoi(port) : TELEMETRY_UDP_PORT);
+    }
+    telemetry_update();
+    sendto(s, &T, sizeof(T), MSG_DONTWAIT, (const struct sockaddr *)&si, sizeof(si));
+#endif
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_TrezorTelemetry_publish_obj, mod_TrezorTelemetry_publish);
+
+#if TREZOR_HEAPPROF
+
+// heap profiler, enabled by building with TREZOR_HEAPPROF=1, which links
+// gc_alloc, gc_realloc and gc_free through the wrappers below
+//
+// live allocations are tracked by their address in a hash table together
+// with the site (the task being stepped, see heap_site) they were made from;
+// blocks freed by the collector are not reported to the wrappers, such
+// entries are recognized by gc_nbytes returning 0 and reused
+
+#if defined TREZOR_UNIX
+#define HEAP_SLOTS 16384
+#else
+#define HEAP_SLOTS 1024
+#endif
+#define HEAP_PROBE 16
+#define HEAP_SITES 32
+#define HEAP_CLASSES 16
+
+#define HEAP_TOMBSTONE ((void *)1)
+
+void *__real_gc_alloc(size_t n_bytes, bool has_finaliser);
+void *__real_gc_realloc(void *ptr, size_t n_bytes, bool allow_move);
+void __real_gc_free(void *ptr);
+
+static bool heap_enabled = false;
+static uint8_t heap_current = 0; // site of new allocations, 0 is unknown
+static uint32_t heap_dropped = 0;
+static qstr heap_sites[HEAP_SITES];
+
+static struct {
+    void *ptr;
+    uint8_t site;
+} heap_slots[HEAP_SLOTS];
+
+static uint32_t heap_hash(const void *ptr) {
+    return (((uintptr_t)ptr / MICROPY_BYTES_PER_GC_BLOCK) * 2654435761u) % HEAP_SLOTS;
+}
+
+static void heap_track(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    const uint32_t h = heap_hash(ptr);
+    int slot = -1;
+    for (int i = 0; i < HEAP_PROBE; i++) {
+        const uint32_t s = (h + i) % HEAP_SLOTS;
+        void *p = heap_slots[s].ptr;
+        if (p == ptr) {
+            slot = s;
+            break;
+        }
+        if (slot < 0 && (p == NULL || p == HEAP_TOMBSTONE || gc_nbytes(p) == 0)) {
+            slot = s;
+        }
+        if (p == NULL) {
+            break;
+        }
+    }
+    if (slot < 0) {
+        heap_dropped++;
+        return;
+    }
+    heap_slots[slot].ptr = ptr;
+    heap_slots[slot].site = heap_current;
+}
+
+static void heap_untrack(void *ptr) {
+    const uint32_t h = heap_hash(ptr);
+    for (int i = 0; i < HEAP_PROBE; i++) {
+        const uint32_t s = (h + i) % HEAP_SLOTS;
+        if (heap_slots[s].ptr == ptr) {
+            heap_slots[s].ptr = HEAP_TOMBSTONE;
+            return;
+        }
+        if (heap_slots[s].ptr == NULL) {
+            return;
+        }
+    }
+}
+
+void *__wrap_gc_alloc(size_t n_bytes, bool has_finaliser) {
+    void *ptr = __real_gc_alloc(n_bytes, has_finaliser);
+    if (heap_enabled) {
+        heap_track(ptr);
+    }
+    return ptr;
+}
+
+void *__wrap_gc_realloc(void *ptr, size_t n_bytes, bool allow_move) {
+    void *p = __real_gc_realloc(ptr, n_bytes, allow_move);
+    if (heap_enabled && p != ptr) {
+        if (ptr != NULL) {
+            heap_untrack(ptr);
+        }
+        heap_track(p);
+    }
+    return p;
+}
+
+void __wrap_gc_free(void *ptr) {
+    if (heap_enabled && ptr != NULL) {
+        heap_untrack(ptr);
+    }
+    __real_gc_free(ptr);
+}
+
+#endif
+
+/// def trezor.telemetry.heap_profile(enable: bool) -> None:
+///     '''
+///     Starts (clearing previous records) or stops tracking of heap allocations.
+///     Does nothing unless the firmware is built with TREZOR_HEAPPROF=1.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_heap_profile(mp_obj_t enable) {
+#if TREZOR_HEAPPROF
+    heap_enabled = false;
+    if (mp_obj_is_true(enable)) {
+        memset(heap_slots, 0, sizeof(heap_slots));
+        memset(heap_sites, 0, sizeof(heap_sites));
+        heap_current = 0;
+        heap_dropped = 0;
+        heap_enabled = true;
+    }
+#endif
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorTelemetry_heap_profile_obj, mod_TrezorTelemetry_heap_profile);
+
+/// def trezor.telemetry.heap_site(name: str) -> None:
+///     '''
+///     Attributes following heap allocations to the site name.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_heap_site(mp_obj_t name) {
+#if TREZOR_HEAPPROF
+    if (!heap_enabled) {
+        return mp_const_none;
+    }
+    const qstr q = mp_obj_str_get_qstr(name);
+    heap_current = 0;
+    for (int i = 1; i < HEAP_SITES; i++) {
+        if (heap_sites[i] == q || heap_sites[i] == MP_QSTR_NULL) {
+            heap_sites[i] = q;
+            heap_current = i;
+            break;
+        }
+    }
+#endif
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorTelemetry_heap_site_obj, mod_TrezorTelemetry_heap_site);
+
+/// def trezor.telemetry.heap_info() -> tuple:
+///     '''
+///     Returns total, free and the largest contiguous free heap size in bytes.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_heap_info(void) {
+    gc_info_t info;
+    gc_info(&info);
+    mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(3, NULL));
+    tuple->items[0] = mp_obj_new_int_from_uint(info.total);
+    tuple->items[1] = mp_obj_new_int_from_uint(info.free);
+    tuple->items[2] = mp_obj_new_int_from_uint(info.max_free * MICROPY_BYTES_PER_GC_BLOCK);
+    return MP_OBJ_FROM_PTR(tuple);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_TrezorTelemetry_heap_info_obj, mod_TrezorTelemetry_heap_info);
+
+/// def trezor.telemetry.heap_report() -> bytes:
+///     '''
+///     Returns a text report of the heap: a "heap <total> <free> <largest free>"
+///     line followed by "<site> <size class> <count> <bytes>" lines of live
+///     allocations, size class being the allocated size rounded down to a power of 2.
+///     '''
+STATIC mp_obj_t mod_TrezorTelemetry_heap_report(void) {
+    gc_info_t info;
+    gc_info(&info);
+#if TREZOR_HEAPPROF
+    const bool enabled = heap_enabled;
+    heap_enabled = false; // don't track the report itself
+#endif
+    vstr_t vstr;
+    vstr_init(&vstr, 256);
+    vstr_printf(&vstr, "heap %u %u %u\n", (unsigned)info.total, (unsigned)info.free, (unsigned)(info.max_free * MICROPY_BYTES_PER_GC_BLOCK));
+#if TREZOR_HEAPPROF
+    if (heap_dropped) {
+        vstr_printf(&vstr, "dropped %u\n", (unsigned)heap_dropped);
+    }
+    for (int site = 0; site < HEAP_SITES; site++) {
+        uint32_t count[HEAP_CLASSES] = {0}, bytes[HEAP_CLASSES] = {0};
+        for (int i = 0; i < HEAP_SLOTS; i++) {
+            void *p = heap_slots[i].ptr;
+            if (p == NULL || p == HEAP_TOMBSTONE || heap_slots[i].site != site) {
+                continue;
+            }
+            const size_t n = gc_nbytes(p);
+            if (n == 0) {
+                heap_slots[i].ptr = HEAP_TOMBSTONE;
+                continue;
+            }
+            int c = 0;
+            while ((n >> c) > 1 && c < HEAP_CLASSES - 1) {
+                c++;
+            }
+            count[c]++;
+            bytes[c] += n;
+        }
+        for (int c = 0; c < HEAP_CLASSES; c++) {
+            if (count[c]) {
+                vstr_printf(&vstr, "%s %u %u %u\n", site ? qstr_str(heap_sites[site]) : "?", 1u << c, (unsigned)count[c], (unsigned)bytes[c]);
+            }
+        }
+    }
+    heap_enabled = enabled;
+#endif
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_TrezorTelemetry_heap_report_obj, mod_TrezorTelemetry_heap_report);
+
+STATIC const mp_rom_map_elem_t mp_module_TrezorTelemetry_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_TrezorTelemetry) },
+    { MP_ROM_QSTR(MP_QSTR_record), MP_ROM_PTR(&mod_TrezorTelemetry_record_obj) },
+    { MP_ROM_QSTR(MP_QSTR_task_resumed), MP_ROM_PTR(&mod_TrezorTelemetry_task_resumed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_task_suspended), MP_ROM_PTR(&mod_TrezorTelemetry_task_suspended_obj) },
+    { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&mod_TrezorTelemetry_collect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_snapshot), MP_ROM_PTR(&mod_TrezorTelemetry_snapshot_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&mod_TrezorTelemetry_reset_obj) },
+    { MP_ROM_QSTR(MP_QSTR_publish), MP_ROM_PTR(&mod_TrezorTelemetry_publish_obj) },
+    { MP_ROM_QSTR(MP_QSTR_heap_profile), MP_ROM_PTR(&mod_TrezorTelemetry_heap_profile_obj) },
+    { MP_ROM_QSTR(MP_QSTR_heap_site), MP_ROM_PTR(&mod_TrezorTelemetry_heap_site_obj) },
+    { MP_ROM_QSTR(MP_QSTR_heap_info), MP_ROM_PTR(&mod_TrezorTelemetry_heap_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_heap_report), MP_ROM_PTR(&mod_TrezorTelemetry_heap_report_obj) },
+    { MP_ROM_QSTR(MP_QSTR_STEP), MP_OBJ_NEW_SMALL_INT(HIST_STEP) },
+    { MP_ROM_QSTR(MP_QSTR_GC), MP_OBJ_NEW_SMALL_INT(HIST_GC) },
+    { MP_ROM_QSTR(MP_QSTR_WAIT_SLEEP), MP_OBJ_NEW_SMALL_INT(HIST_WAIT_SLEEP) },
+    { MP_ROM_QSTR(MP_QSTR_WAIT_SELECT), MP_OBJ_NEW_SMALL_INT(HIST_WAIT_SELECT) },
+    { MP_ROM_QSTR(MP_QSTR_WAIT_SIGNAL), MP_OBJ_NEW_SMALL_INT(HIST_WAIT_SIGNAL) },
+    { MP_ROM_QSTR(MP_QSTR_WAIT_WAIT), MP_OBJ_NEW_SMALL_INT(HIST_WAIT_WAIT) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_module_TrezorTelemetry_globals, mp_module_TrezorTelemetry_globals_table);
+
+const mp_obj_module_t mp_module_TrezorTelemetry = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&mp_module_TrezorTelemetry_globals,
+};
+
+#endif // MICROPY_PY_TREZORTELEMETRY
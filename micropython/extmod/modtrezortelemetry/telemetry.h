@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) Pavol Rusnak, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <stdint.h>
+
+// counters maintained directly by other native modules
+
+#define TELEMETRY_REPORT_RX 0
+#define TELEMETRY_REPORT_TX 1
+
+#define TELEMETRY_COUNTERS  2
+
+extern uint32_t telemetry_counters[TELEMETRY_COUNTERS];
+
+#endif
@@ -287,9 +287,10 @@ static void display_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y
 #endif
 }
 
-void display_refresh(void) {
+int display_refresh(void) {
     while (GPIO_PIN_RESET == HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_12)) { }
     while (GPIO_PIN_SET == HAL_GPIO_ReadPin(GPIOD, GPIO_PIN_12)) { }
+    return 1;
 }
 
 void display_save(const char *filename)
@@ -6,21 +6,37 @@
  */
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #ifndef TREZOR_NOUI
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 
 #define DISPLAY_BORDER 16
 
 static SDL_Renderer *RENDERER = 0;
-static SDL_Surface  *BUFFER   = 0;
 static SDL_Texture  *TEXTURE  = 0;
+int HEADLESS = 0;  // also read by touch_read in unix/touch.c
+// set by every drawing primitive (through display_set_window),
+// display_refresh doesn't present the frame again until it is set
+static int DIRTY = 1;
+#endif
+
+// the display contents are kept in an RGB565 framebuffer (in host byte
+// order), which is either private or, when TREZOR_FRAMEBUFFER names a file,
+// shared with other processes through that file
+//
+// headless mode (TREZOR_NOUI builds, or TREZOR_HEADLESS set in environment)
+// skips SDL entirely and leaves the framebuffer as the only output
+
+static uint16_t *FRAMEBUFFER = 0;
 static int DATAODD = 0;
 static int POSX, POSY, SX, SY, EX, EY = 0;
 
 void DATA(uint8_t x) {
     if (POSX <= EX && POSY <= EY) {
-        ((uint8_t *)BUFFER->pixels)[POSX * 2 + POSY * BUFFER->pitch + (DATAODD ^ 1)] = x;
+        ((uint8_t *)FRAMEBUFFER)[(POSX + POSY * DISPLAY_RESX) * 2 + (DATAODD ^ 1)] = x;
     }
     DATAODD = !DATAODD;
     if (DATAODD == 0) {
@@ -31,13 +47,33 @@ void DATA(uint8_t x) {
         }
     }
 }
-#else
-#define DATA(X) (void)(X);
-#endif
+
+static uint16_t *framebuffer_alloc(void)
+{
+    const size_t size = DISPLAY_RESX * DISPLAY_RESY * sizeof(uint16_t);
+    const char *path = getenv("TREZOR_FRAMEBUFFER");
+    if (path) {
+        int fd = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd >= 0 && ftruncate(fd, size) == 0) {
+            void *fb = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (fb != MAP_FAILED) {
+                return fb;
+            }
+        }
+        printf("Cannot map framebuffer file %s, using private one\n", path);
+    }
+    return calloc(1, size);
+}
 
 int display_init(void)
 {
+    FRAMEBUFFER = framebuffer_alloc();
 #ifndef TREZOR_NOUI
+    HEADLESS = getenv("TREZOR_HEADLESS") != NULL;
+    if (HEADLESS) {
+        return 0;
+    }
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         printf("SDL_Init Error: %s\n", SDL_GetError());
     }
@@ -54,7 +90,6 @@ int display_init(void)
     }
     SDL_SetRenderDrawColor(RENDERER, DISPLAY_BACKLIGHT, DISPLAY_BACKLIGHT, DISPLAY_BACKLIGHT, 255);
     SDL_RenderClear(RENDERER);
-    BUFFER = SDL_CreateRGBSurface(0, DISPLAY_RESX, DISPLAY_RESY, 16, 0xF800, 0x07E0, 0x001F, 0x0000);
     TEXTURE = SDL_CreateTexture(RENDERER, SDL_PIXELFORMAT_RGB565, SDL_TEXTUREACCESS_STREAMING, DISPLAY_RESX, DISPLAY_RESY);
     SDL_SetTextureBlendMode(TEXTURE, SDL_BLENDMODE_NONE);
     SDL_SetTextureAlphaMod(TEXTURE, 0);
@@ -64,39 +99,149 @@ int display_init(void)
 
 static void display_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-#ifndef TREZOR_NOUI
     SX = x0; SY = y0;
     EX = x1; EY = y1;
     POSX = SX; POSY = SY;
     DATAODD = 0;
+#ifndef TREZOR_NOUI
+    DIRTY = 1;
 #endif
 }
 
-void display_refresh(void)
+int display_refresh(void)
 {
 #ifndef TREZOR_NOUI
+    if (!DIRTY) {
+        return 0;
+    }
+    DIRTY = 0;
+    if (HEADLESS) {
+        return 1;  // the framebuffer is the presented frame
+    }
     SDL_RenderClear(RENDERER);
-    SDL_UpdateTexture(TEXTURE, NULL, BUFFER->pixels, BUFFER->pitch);
+    SDL_UpdateTexture(TEXTURE, NULL, FRAMEBUFFER, DISPLAY_RESX * sizeof(uint16_t));
     const SDL_Rect r = {DISPLAY_BORDER, DISPLAY_BORDER, DISPLAY_RESX, DISPLAY_RESY};
     SDL_RenderCopyEx(RENDERER, TEXTURE, NULL, &r, DISPLAY_ORIENTATION, NULL, 0);
     SDL_RenderPresent(RENDERER);
+    return 1;
+#else
+    return 0;
 #endif
 }
 
 static void display_set_orientation(int degrees)
 {
+#ifndef TREZOR_NOUI
+    DIRTY = 1;
+#endif
 }
 
 static void display_set_backlight(int val)
 {
 #ifndef TREZOR_NOUI
+    if (HEADLESS) {
+        return;
+    }
     SDL_SetRenderDrawColor(RENDERER, val, val, val, 255);
+    DIRTY = 1;
 #endif
 }
 
+static uint32_t png_crc(uint32_t crc, const uint8_t *data, size_t len)
+{
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void png_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static void png_chunk(FILE *f, const char *type, const uint8_t *data, size_t len)
+{
+    uint8_t buf[8];
+    png_u32(buf, len);
+    memcpy(buf + 4, type, 4);
+    fwrite(buf, 1, 8, f);
+    fwrite(data, 1, len, f);
+    png_u32(buf, png_crc(png_crc(0, (const uint8_t *)type, 4), data, len));
+    fwrite(buf, 1, 4, f);
+}
+
+// writes the framebuffer as RGB PNG using uncompressed deflate blocks,
+// so saving costs just a copy of the pixels
+static void display_save_png(FILE *f)
+{
+    #define PNG_ROW (1 + DISPLAY_RESX * 3)
+    #define PNG_RAW (PNG_ROW * DISPLAY_RESY)
+    #define PNG_BLOCK 65535
+    static uint8_t raw[PNG_RAW];
+    static uint8_t idat[2 + PNG_RAW + (PNG_RAW / PNG_BLOCK + 1) * 5 + 4];
+    uint8_t *p = raw;
+    for (int y = 0; y < DISPLAY_RESY; y++) {
+        *p++ = 0; // filter: none
+        for (int x = 0; x < DISPLAY_RESX; x++) {
+            const uint16_t c = FRAMEBUFFER[x + y * DISPLAY_RESX];
+            *p++ = ((c >> 11) & 0x1F) * 255 / 0x1F;
+            *p++ = ((c >> 5) & 0x3F) * 255 / 0x3F;
+            *p++ = (c & 0x1F) * 255 / 0x1F;
+        }
+    }
+    // zlib stream of stored blocks
+    uint8_t *q = idat;
+    *q++ = 0x78; *q++ = 0x01;
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < PNG_RAW; i += PNG_BLOCK) {
+        const size_t n = (PNG_RAW - i < PNG_BLOCK) ? PNG_RAW - i : PNG_BLOCK;
+        *q++ = (i + n == PNG_RAW);
+        *q++ = n & 0xFF; *q++ = n >> 8;
+        *q++ = ~n & 0xFF; *q++ = (~n >> 8) & 0xFF;
+        memcpy(q, raw + i, n);
+        q += n;
+        for (size_t k = 0; k < n; k++) {
+            a = (a + raw[i + k]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    png_u32(q, (b << 16) | a);
+    q += 4;
+    uint8_t ihdr[13] = {0, 0, 0, 0, 0, 0, 0, 0, 8, 2, 0, 0, 0}; // 8-bit RGB
+    png_u32(ihdr, DISPLAY_RESX);
+    png_u32(ihdr + 4, DISPLAY_RESY);
+    fwrite("\x89PNG\r\n\x1a\n", 1, 8, f);
+    png_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    png_chunk(f, "IDAT", idat, q - idat);
+    png_chunk(f, "IEND", NULL, 0);
+    #undef PNG_ROW
+    #undef PNG_RAW
+    #undef PNG_BLOCK
+}
+
 void display_save(const char *filename)
 {
-#ifndef TREZOR_NOUI
-    IMG_SavePNG(BUFFER, filename);
-#endif
+    FILE *f = fopen(filename, "wb");
+    if (!f) {
+        return;
+    }
+    const size_t len = strlen(filename);
+    if (len >= 4 && strcmp(filename + len - 4, ".raw") == 0) {
+        fwrite(FRAMEBUFFER, sizeof(uint16_t), DISPLAY_RESX * DISPLAY_RESY, f);
+    } else {
+        display_save_png(f);
+    }
+    fclose(f);
 }
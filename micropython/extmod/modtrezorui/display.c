@@ -28,6 +28,22 @@ static int DISPLAY_OFFSET[2] = {0, 0};
 #error Unsupported TREZOR port. Only STM32 and UNIX ports are supported.
 #endif
 
+// set when the loader is the last thing drawn, so that it can be updated
+// incrementally
+static int LOADER_VALID = 0;
+// number of bytes sent to the display
+static uint32_t DISPLAY_BYTES = 0;
+
+// every drawing primitive sets up its window through here
+static void display_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    LOADER_VALID = 0;
+    if (x0 <= x1 && y0 <= y1) {
+        DISPLAY_BYTES += (x1 - x0 + 1) * (y1 - y0 + 1) * 2;
+    }
+    display_set_window(x0, y0, x1, y1);
+}
+
 // common display functions
 
 static void set_color_table(uint16_t colortable[16], uint16_t fgcolor, uint16_t bgcolor)
@@ -41,6 +57,33 @@ static void set_color_table(uint16_t colortable[16], uint16_t fgcolor, uint16_t
     }
 }
 
+// the same few color pairs are used over and over (text, buttons),
+// so their color tables are kept around
+#define COLORTABLE_CACHE_SIZE 4
+
+static const uint16_t *get_color_table(uint16_t fgcolor, uint16_t bgcolor)
+{
+    static struct {
+        uint16_t fgcolor, bgcolor;
+        uint16_t colortable[16];
+    } cache[COLORTABLE_CACHE_SIZE];
+    static int used = 0, next = 0;
+    for (int i = 0; i < used; i++) {
+        if (cache[i].fgcolor == fgcolor && cache[i].bgcolor == bgcolor) {
+            return cache[i].colortable;
+        }
+    }
+    int i = next;
+    next = (next + 1) % COLORTABLE_CACHE_SIZE;
+    if (used < COLORTABLE_CACHE_SIZE) {
+        used++;
+    }
+    cache[i].fgcolor = fgcolor;
+    cache[i].bgcolor = bgcolor;
+    set_color_table(cache[i].colortable, fgcolor, bgcolor);
+    return cache[i].colortable;
+}
+
 static inline void clamp_coords(int x, int y, int w, int h, int *x0, int *y0, int *x1, int *y1)
 {
 #define MIN(a,b) (((a)<(b))?(a):(b))
@@ -53,7 +96,7 @@ static inline void clamp_coords(int x, int y, int w, int h, int *x0, int *y0, in
 
 void display_clear(void)
 {
-    display_set_window(0, 0, DISPLAY_RESX - 1, DISPLAY_RESY - 1);
+    display_window(0, 0, DISPLAY_RESX - 1, DISPLAY_RESY - 1);
     for (int i = 0; i < DISPLAY_RESX * DISPLAY_RESY * 2; i++) {
         DATA(0x00);
     }
@@ -65,7 +108,7 @@ void display_bar(int x, int y, int w, int h, uint16_t c)
     y += DISPLAY_OFFSET[1];
     int x0, y0, x1, y1;
     clamp_coords(x, y, w, h, &x0, &y0, &x1, &y1);
-    display_set_window(x0, y0, x1, y1);
+    display_window(x0, y0, x1, y1);
     for (int i = 0; i < (x1 - x0 + 1) * (y1 - y0 + 1); i++) {
         DATA(c >> 8);
         DATA(c & 0xFF);
@@ -100,13 +143,12 @@ void display_bar_radius(int x, int y, int w, int h, uint16_t c, uint16_t b, uint
     } else {
         r = 16 / r;
     }
-    uint16_t colortable[16];
-    set_color_table(colortable, c, b);
+    const uint16_t *colortable = get_color_table(c, b);
     x += DISPLAY_OFFSET[0];
     y += DISPLAY_OFFSET[1];
     int x0, y0, x1, y1;
     clamp_coords(x, y, w, h, &x0, &y0, &x1, &y1);
-    display_set_window(x0, y0, x1, y1);
+    display_window(x0, y0, x1, y1);
     for (int j = y0; j <= y1; j++) {
         for (int i = x0; i <= x1; i++) {
             int rx = i - x;
@@ -158,7 +200,7 @@ void display_image(int x, int y, int w, int h, const void *data, int datalen)
     y += DISPLAY_OFFSET[1];
     int x0, y0, x1, y1;
     clamp_coords(x, y, w, h, &x0, &y0, &x1, &y1);
-    display_set_window(x0, y0, x1, y1);
+    display_window(x0, y0, x1, y1);
     int userdata[5];
     userdata[0] = w;
     userdata[1] = x0 - x;
@@ -193,7 +235,7 @@ void display_icon(int x, int y, int w, int h, const void *data, int datalen, uin
     x &= ~1; // cannot draw at odd coordinate
     int x0, y0, x1, y1;
     clamp_coords(x, y, w, h, &x0, &y0, &x1, &y1);
-    display_set_window(x0, y0, x1, y1);
+    display_window(x0, y0, x1, y1);
     int userdata[5 + 16 * sizeof(uint16_t) / sizeof(int)];
     userdata[0] = w;
     userdata[1] = x0 - x;
@@ -204,30 +246,153 @@ void display_icon(int x, int y, int w, int h, const void *data, int datalen, uin
     sinf_inflate(data, datalen, inflate_callback_icon, userdata);
 }
 
-static const uint8_t *get_glyph(uint8_t font, uint8_t c)
+static const font_info *get_font(uint8_t font)
 {
-    if (c >= ' ' && c <= '~') {
-    // do nothing - valid ASCII
-    } else
-    // UTF-8 handling: https://en.wikipedia.org/wiki/UTF-8#Description
-    if (c >= 0xC0) {
-        // bytes 11xxxxxx are first byte of UTF-8 characters
-        c = '_';
-    } else {
-        // bytes 10xxxxxx are successive UTF-8 characters
-        return 0;
-    }
     switch (font) {
         case FONT_MONO:
-            return Font_RobotoMono_Regular_20[c - ' '];
+            return &Font_RobotoMono_Regular_20;
         case FONT_NORMAL:
-            return Font_Roboto_Regular_20[c - ' '];
+            return &Font_Roboto_Regular_20;
         case FONT_BOLD:
-            return Font_Roboto_Bold_20[c - ' '];
+            return &Font_Roboto_Bold_20;
+    }
+    return 0;
+}
+
+// decodes the UTF-8 sequence at text[*i] and moves *i past it,
+// returns 0 for invalid sequences
+static uint32_t utf8_next(const char *text, int textlen, int *i)
+{
+    // https://en.wikipedia.org/wiki/UTF-8#Description
+    uint8_t c = (uint8_t)text[(*i)++];
+    if (c < 0x80) {
+        return c;
+    }
+    int n;
+    uint32_t cp;
+    if ((c & 0xE0) == 0xC0) {
+        n = 1; cp = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        n = 2; cp = c & 0x0F;
+    } else if ((c & 0xF8) == 0xF0) {
+        n = 3; cp = c & 0x07;
+    } else {
+        // stray continuation byte
+        return 0;
+    }
+    for (; n > 0; n--) {
+        if (*i >= textlen || ((uint8_t)text[*i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        cp = (cp << 6) | ((uint8_t)text[(*i)++] & 0x3F);
+    }
+    return cp;
+}
+
+static const uint8_t *get_glyph(const font_info *f, uint32_t cp)
+{
+    // control characters are not rendered
+    if (!f || cp < ' ' || (cp >= 0x7F && cp < 0xA0)) {
+        return 0;
+    }
+    // glyphs of the leading block (ASCII) are indexed directly
+    const uint32_t first = f->codepoints[0];
+    if (cp >= first && cp - first < f->count && f->codepoints[cp - first] == cp) {
+        return f->glyphs[cp - first];
+    }
+    int lo = 0, hi = f->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (f->codepoints[mid] < cp) {
+            lo = mid + 1;
+        } else if (f->codepoints[mid] > cp) {
+            hi = mid - 1;
+        } else {
+            return f->glyphs[mid];
+        }
+    }
+    // printable characters missing in the font are rendered as underscore
+    return cp != '_' ? get_glyph(f, '_') : 0;
+}
+
+static int get_kerning(const font_info *f, uint32_t left, uint32_t right)
+{
+    if (f->kerning_count == 0 || left == 0 || left > 0xFFFF || right > 0xFFFF) {
+        return 0;
+    }
+    const uint32_t key = (left << 16) | right;
+    int lo = 0, hi = f->kerning_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (f->kerning_pairs[mid] < key) {
+            lo = mid + 1;
+        } else if (f->kerning_pairs[mid] > key) {
+            hi = mid - 1;
+        } else {
+            return f->kerning_values[mid];
+        }
     }
     return 0;
 }
 
+#if TREZOR_FONT_COMPRESSED
+
+// compressed glyphs are decoded into a small cache, evicting the least
+// recently used slot; a glyph run never holds more than GLYPH_CACHE_SIZE - 1
+// glyphs of a compressed font, so its glyphs can't be evicted mid-run
+#define GLYPH_CACHE_SIZE 6
+#define GLYPH_CACHE_DATA 256
+
+static const uint8_t *get_glyph_data(const font_info *f, const uint8_t *g)
+{
+    if (!f->compressed) {
+        return g + 5;
+    }
+    static struct {
+        const uint8_t *glyph;
+        uint32_t used;
+        uint8_t data[GLYPH_CACHE_DATA];
+    } cache[GLYPH_CACHE_SIZE];
+    static uint32_t tick = 0;
+    tick++;
+    int slot = 0;
+    for (int i = 0; i < GLYPH_CACHE_SIZE; i++) {
+        if (cache[i].glyph == g) {
+            cache[i].used = tick;
+            return cache[i].data;
+        }
+        if (cache[i].used < cache[slot].used) {
+            slot = i;
+        }
+    }
+    // expand runs of 0 and 15 back into packed 4-bit data
+    const int total = MIN(g[0] * g[1], GLYPH_CACHE_DATA * 2);
+    const uint8_t *src = g + 5;
+    uint8_t *dst = cache[slot].data;
+    memset(dst, 0, GLYPH_CACHE_DATA);
+    #define NEXT_NIBBLE() ((s % 2) ? (src[s++ / 2] & 0x0F) : (src[s++ / 2] >> 4))
+    for (int a = 0, s = 0; a < total;) {
+        const uint8_t v = NEXT_NIBBLE();
+        const int n = (v == 0x0 || v == 0xF) ? NEXT_NIBBLE() + 1 : 1;
+        for (int k = 0; k < n && a < total; k++, a++) {
+            dst[a / 2] |= (a % 2) ? v : (v << 4);
+        }
+    }
+    #undef NEXT_NIBBLE
+    cache[slot].glyph = g;
+    cache[slot].used = tick;
+    return cache[slot].data;
+}
+
+#else
+
+static const uint8_t *get_glyph_data(const font_info *f, const uint8_t *g)
+{
+    return g + 5;
+}
+
+#endif
+
 #define DISPLAY_PRINT_COLS (DISPLAY_RESX / 6)
 #define DISPLAY_PRINT_ROWS (DISPLAY_RESY / 8)
 static char display_print_buf[DISPLAY_PRINT_ROWS][DISPLAY_PRINT_COLS];
@@ -271,7 +436,7 @@ void display_print(const char *text, int textlen)
 
 // display text using bitmap font - send internal buffer to display
 void display_print_out(uint16_t fgcolor, uint16_t bgcolor) {
-    display_set_window(0, 0, DISPLAY_RESX - 1, DISPLAY_RESY - 1);
+    display_window(0, 0, DISPLAY_RESX - 1, DISPLAY_RESY - 1);
     for (int i = 0; i < DISPLAY_RESX * DISPLAY_RESY; i++) {
         int x = (i % DISPLAY_RESX);
         int y = (i / DISPLAY_RESX);
@@ -291,13 +456,85 @@ void display_print_out(uint16_t fgcolor, uint16_t bgcolor) {
     }
 }
 
-// first two bytes are width and height of the glyph
-// third, fourth and fifth bytes are advance, bearingX and bearingY of the horizontal metrics of the glyph
-// rest is packed 4-bit glyph data
+// maximum number of glyphs rendered in one window
+#define TEXT_RUN_MAX 32
+
+// cost of setting up a window, in pixels (11 bus writes on STM32)
+#define TEXT_WINDOW_COST 6
+
+// renders a run of glyphs through a single window covering all of them,
+// row by row from left to right; pixels between the glyphs are painted
+// with background, where glyphs overlap the earlier one wins
+static void display_glyph_run(const uint8_t * const *glyphs, const uint8_t * const *data, const int *gx, int count, int y, const uint16_t *colortable)
+{
+    if (count == 0) return;
+    // bounding box of the run
+    int bx0 = gx[0], by0 = y - (int8_t)(glyphs[0][4]);
+    int bx1 = bx0 + glyphs[0][0] - 1, by1 = by0 + glyphs[0][1] - 1;
+    for (int k = 1; k < count; k++) {
+        const uint8_t *g = glyphs[k];
+        int sy = y - (int8_t)(g[4]);
+        bx0 = MIN(bx0, gx[k]);
+        by0 = MIN(by0, sy);
+        bx1 = MAX(bx1, gx[k] + g[0] - 1);
+        by1 = MAX(by1, sy + g[1] - 1);
+    }
+    int x0, y0, x1, y1;
+    clamp_coords(bx0, by0, bx1 - bx0 + 1, by1 - by0 + 1, &x0, &y0, &x1, &y1);
+    if (x0 > x1 || y0 > y1) return;
+    display_window(x0, y0, x1, y1);
+    #define PUT_PIXEL(C) do { DATA(colortable[(C)] >> 8); DATA(colortable[(C)] & 0xFF); } while (0)
+    for (int j = y0; j <= y1; j++) {
+        int cursor = x0;
+        for (int k = 0; k < count; k++) {
+            const uint8_t *g = glyphs[k];
+            // g[0], g[1] = width, height
+            // g[2]       = advance
+            // g[3], g[4] = bearingX, bearingY
+            const int w = g[0];
+            const int ry = j - (y - (int8_t)(g[4]));
+            // visible columns of the glyph row
+            const int c0 = MAX(cursor - gx[k], 0);
+            const int c1 = MIN(x1 - gx[k], w - 1);
+            int n = c1 - c0 + 1;
+            if (n <= 0) continue;
+            for (; cursor < gx[k] + c0; cursor++) {
+                PUT_PIXEL(0);
+            }
+            cursor += n;
+            if (ry < 0 || ry >= g[1]) {
+                for (; n > 0; n--) {
+                    PUT_PIXEL(0);
+                }
+                continue;
+            }
+            int a = c0 + ry * w;
+            if (a % 2) {
+                PUT_PIXEL(data[k][a / 2] & 0x0F);
+                a++;
+                n--;
+            }
+            const uint8_t *d = data[k] + a / 2;
+            for (; n >= 2; n -= 2, d++) {
+                PUT_PIXEL(*d >> 4);
+                PUT_PIXEL(*d & 0x0F);
+            }
+            if (n) {
+                PUT_PIXEL(*d >> 4);
+            }
+        }
+        for (; cursor <= x1; cursor++) {
+            PUT_PIXEL(0);
+        }
+    }
+    #undef PUT_PIXEL
+}
+
 void display_text(int x, int y, const char *text, int textlen, uint8_t font, uint16_t fgcolor, uint16_t bgcolor)
 {
-    uint16_t colortable[16];
-    set_color_table(colortable, fgcolor, bgcolor);
+    const font_info *f = get_font(font);
+    if (!f) return;
+    const uint16_t *colortable = get_color_table(fgcolor, bgcolor);
 
     // determine text length if not provided
     if (textlen < 0) {
@@ -306,39 +543,51 @@ void display_text(int x, int y, const char *text, int textlen, uint8_t font, uin
 
     int px = x + DISPLAY_OFFSET[0];
     y += DISPLAY_OFFSET[1];
-    // render glyphs
-    for (int i = 0; i < textlen; i++) {
-        const uint8_t *g = get_glyph(font, (uint8_t)text[i]);
+    // lay out glyphs into runs and render them, a glyph joins the current
+    // run only if painting the gap to it is cheaper than a new window
+#if TREZOR_FONT_COMPRESSED
+    const int runmax = f->compressed ? GLYPH_CACHE_SIZE - 1 : TEXT_RUN_MAX;
+#else
+    const int runmax = TEXT_RUN_MAX;
+#endif
+    const uint8_t *run[TEXT_RUN_MAX];
+    const uint8_t *rundata[TEXT_RUN_MAX];
+    int runx[TEXT_RUN_MAX];
+    int count = 0;
+    int rx0 = 0, ry0 = 0, rx1 = 0, ry1 = 0;
+    uint32_t prev = 0;
+    for (int i = 0; i < textlen;) {
+        const uint32_t cp = utf8_next(text, textlen, &i);
+        const uint8_t *g = get_glyph(f, cp);
         if (!g) continue;
-        // g[0], g[1] = width, height
-        // g[2]       = advance
-        // g[3], g[4] = bearingX, bearingY
+        px += get_kerning(f, prev, cp);
+        prev = cp;
         if (g[0] && g[1]) {
-            int sx = px + (int8_t)(g[3]);
-            int sy = y - (int8_t)(g[4]);
-            int w = g[0];
-            int h = g[1];
-            int x0, y0, x1, y1;
-            clamp_coords(sx, sy, w, h, &x0, &y0, &x1, &y1);
-            display_set_window(x0, y0, x1, y1);
-            for (int j = y0; j <= y1; j++) {
-                for (int i = x0; i <= x1; i++) {
-                    int rx = i - sx;
-                    int ry = j - sy;
-                    int a = rx + ry * w;
-                    uint8_t c;
-                    if (a % 2 == 0) {
-                        c = g[5 + a/2] >> 4;
-                    } else {
-                        c = g[5 + a/2] & 0x0F;
-                    }
-                    DATA(colortable[c] >> 8);
-                    DATA(colortable[c] & 0xFF);
+            const int gx0 = px + (int8_t)(g[3]), gy0 = y - (int8_t)(g[4]);
+            const int gx1 = gx0 + g[0] - 1, gy1 = gy0 + g[1] - 1;
+            if (count > 0) {
+                const int mx0 = MIN(rx0, gx0), my0 = MIN(ry0, gy0);
+                const int mx1 = MAX(rx1, gx1), my1 = MAX(ry1, gy1);
+                const int merged = (mx1 - mx0 + 1) * (my1 - my0 + 1);
+                const int separate = (rx1 - rx0 + 1) * (ry1 - ry0 + 1) + g[0] * g[1] + TEXT_WINDOW_COST;
+                if (count == runmax || merged > separate) {
+                    display_glyph_run(run, rundata, runx, count, y, colortable);
+                    count = 0;
+                } else {
+                    rx0 = mx0; ry0 = my0; rx1 = mx1; ry1 = my1;
                 }
             }
+            if (count == 0) {
+                rx0 = gx0; ry0 = gy0; rx1 = gx1; ry1 = gy1;
+            }
+            run[count] = g;
+            rundata[count] = get_glyph_data(f, g);
+            runx[count] = gx0;
+            count++;
         }
         px += g[2];
     }
+    display_glyph_run(run, rundata, runx, count, y, colortable);
 }
 
 void display_text_center(int x, int y, const char *text, int textlen, uint8_t font, uint16_t fgcolor, uint16_t bgcolor)
@@ -361,40 +610,76 @@ int display_text_width(const char *text, int textlen, uint8_t font)
     if (textlen < 0) {
         textlen = strlen(text);
     }
-    for (int i = 0; i < textlen; i++) {
-        const uint8_t *g = get_glyph(font, (uint8_t)text[i]);
+    const font_info *f = get_font(font);
+    uint32_t prev = 0;
+    for (int i = 0; i < textlen;) {
+        const uint32_t cp = utf8_next(text, textlen, &i);
+        const uint8_t *g = get_glyph(f, cp);
         if (!g) continue;
-        w += g[2];
+        w += get_kerning(f, prev, cp) + g[2];
+        prev = cp;
     }
     return w;
 }
 
+// returns the side of the QR code (in modules) or 0 if encoding failed,
+// bitdata has to hold QR_MAX_BITDATA bytes
+int display_qrcode_prepare(const char *data, int datalen, uint8_t *bitdata)
+{
+    return qr_encode(QR_LEVEL_M, 0, data, datalen, bitdata);
+}
+
 void display_qrcode(int x, int y, const char *data, int datalen, uint8_t scale)
 {
     if (scale < 1 || scale > 10) return;
     uint8_t bitdata[QR_MAX_BITDATA];
-    int side = qr_encode(QR_LEVEL_M, 0, data, datalen, bitdata);
-    x += DISPLAY_OFFSET[0] - (side + 2) * scale / 2;
-    y += DISPLAY_OFFSET[1] - (side + 2) * scale / 2;
+    int side = display_qrcode_prepare(data, datalen, bitdata);
+    display_qrcode_bitmap(x, y, bitdata, side, scale);
+}
+
+// renders a QR code bitmap (modules stored by columns, as produced by
+// qr_encode) centered at position (x, y) with 1 module of border; each row
+// of modules is expanded into runs of pixels once and repeated scale times
+void display_qrcode_bitmap(int x, int y, const uint8_t *bitdata, int side, uint8_t scale)
+{
+    if (scale < 1 || scale > 10 || side <= 0) return;
+    const int size = (side + 2) * scale;
+    x += DISPLAY_OFFSET[0] - size / 2;
+    y += DISPLAY_OFFSET[1] - size / 2;
     int x0, y0, x1, y1;
-    clamp_coords(x, y, (side + 2) * scale, (side + 2) * scale, &x0, &y0, &x1, &y1);
-    display_set_window(x0, y0, x1, y1);
-    for (int j = y0; j <= y1; j++) {
-        for (int i = x0; i <= x1; i++) {
-            int rx = (i - x) / scale - 1;
-            int ry = (j - y) / scale - 1;
+    clamp_coords(x, y, size, size, &x0, &y0, &x1, &y1);
+    if (x0 > x1 || y0 > y1) return;
+    display_window(x0, y0, x1, y1);
+    // alternating runs of white and black pixels, starting with white
+    uint16_t runs[DISPLAY_RESX + 1];
+    for (int j = y0; j <= y1;) {
+        const int ry = (j - y) / scale - 1;
+        int count = 0, black = 0;
+        runs[0] = 0;
+        for (int rx = -1; rx <= side; rx++) {
+            const int s0 = MAX(x + (rx + 1) * scale, x0);
+            const int s1 = MIN(x + (rx + 2) * scale - 1, x1);
+            if (s0 > s1) continue;
+            int a = rx * side + ry;
             // 1px border
-            if (rx < 0 || ry < 0 || rx >= side || ry >= side) {
-                DATA(0xFF); DATA(0xFF);
-                continue;
+            int b = rx >= 0 && ry >= 0 && rx < side && ry < side && (bitdata[a / 8] & (1 << (7 - a % 8)));
+            if (b != black) {
+                runs[++count] = 0;
+                black = b;
             }
-            int a = rx * side + ry;
-            if (bitdata[a / 8] & (1 << (7 - a % 8))) {
-                DATA(0x00); DATA(0x00);
-            } else {
-                DATA(0xFF); DATA(0xFF);
+            runs[count] += s1 - s0 + 1;
+        }
+        // emit the row for all pixel rows of this module row
+        const int rows = MIN(y + (ry + 2) * scale, y1 + 1) - j;
+        for (int r = 0; r < rows; r++) {
+            for (int k = 0; k <= count; k++) {
+                const uint8_t c = (k % 2) ? 0x00 : 0xFF;
+                for (int n = runs[k]; n > 0; n--) {
+                    DATA(c); DATA(c);
+                }
             }
         }
+        j += rows;
     }
 }
 
@@ -406,18 +691,67 @@ static void inflate_callback_loader(uint8_t byte, uint32_t pos, void *userdata)
     out[pos] = byte;
 }
 
+// repaints pixels of the ring with angle in [a0, a1) of the quadrant, which
+// is mirrored horizontally (mirrorx) and/or vertically (mirrory) from the
+// top-left one and covers progress a = base + sign * angle
+static void loader_ring_update(int a0, int a1, int mirrorx, int mirrory, int base, int sign, uint16_t progress, int yoffset, const uint16_t *colortable)
+{
+    a0 = MAX(a0, 0);
+    a1 = MIN(a1, 250);
+    if (a0 >= a1) return;
+    const int x0 = DISPLAY_RESX / 2 - img_loader_size, y0 = DISPLAY_RESY / 2 - img_loader_size + yoffset;
+    for (int i = img_loader_ring_index[a0]; i < img_loader_ring_index[a1]; i++) {
+        const int mx = img_loader_ring[i] & 0xFF, my = img_loader_ring[i] >> 8;
+        const int x = x0 + (mirrorx ? img_loader_size * 2 - 1 - mx : mx);
+        const int y = y0 + (mirrory ? img_loader_size * 2 - 1 - my : my);
+        const uint16_t v = img_loader[my][mx];
+        const uint8_t c = (progress > base + sign * (v >> 8)) ? (v & 0x00F0) >> 4 : v & 0x000F;
+        display_window(x, y, x, y);
+        DATA(colortable[c] >> 8);
+        DATA(colortable[c] & 0xFF);
+    }
+}
+
 void display_loader(uint16_t progress, int yoffset, uint16_t fgcolor, uint16_t bgcolor, const uint8_t *icon, uint32_t iconlen, uint16_t iconfgcolor)
 {
+    // state of the loader on the screen
+    static struct {
+        uint16_t progress;
+        int yoffset;
+        uint16_t fgcolor, bgcolor, iconfgcolor;
+        const uint8_t *icon;
+        uint32_t iconlen;
+    } last;
     uint16_t colortable[16], iconcolortable[16];
     set_color_table(colortable, fgcolor, bgcolor);
-    if (icon) {
-        set_color_table(iconcolortable, iconfgcolor, bgcolor);
-    }
     if ((DISPLAY_RESY / 2 - img_loader_size + yoffset < 0) ||
         (DISPLAY_RESY / 2 + img_loader_size - 1 + yoffset >= DISPLAY_RESY)) {
        return;
     }
-    display_set_window(DISPLAY_RESX / 2 - img_loader_size, DISPLAY_RESY / 2 - img_loader_size + yoffset, DISPLAY_RESX / 2 + img_loader_size - 1, DISPLAY_RESY / 2 + img_loader_size - 1 + yoffset);
+    // only the progress changed, repaint just the part of the ring between
+    // the old and new progress
+    if (LOADER_VALID && last.yoffset == yoffset && last.fgcolor == fgcolor && last.bgcolor == bgcolor &&
+        last.icon == icon && last.iconlen == iconlen && (!icon || last.iconfgcolor == iconfgcolor)) {
+        const int lo = MIN(last.progress, progress), hi = MAX(last.progress, progress);
+        loader_ring_update(lo, hi, 1, 0, 0, 1, progress, yoffset, colortable);                  // top right
+        loader_ring_update(500 - hi, 500 - lo, 1, 1, 499, -1, progress, yoffset, colortable);   // bottom right
+        loader_ring_update(lo - 500, hi - 500, 0, 1, 500, 1, progress, yoffset, colortable);    // bottom left
+        loader_ring_update(1000 - hi, 1000 - lo, 0, 0, 999, -1, progress, yoffset, colortable); // top left
+        last.progress = progress;
+        LOADER_VALID = 1;
+        return;
+    }
+    last.progress = progress;
+    last.yoffset = yoffset;
+    last.fgcolor = fgcolor;
+    last.bgcolor = bgcolor;
+    last.iconfgcolor = iconfgcolor;
+    last.icon = icon;
+    last.iconlen = iconlen;
+    if (icon) {
+        set_color_table(iconcolortable, iconfgcolor, bgcolor);
+    }
+    display_window(DISPLAY_RESX / 2 - img_loader_size, DISPLAY_RESY / 2 - img_loader_size + yoffset, DISPLAY_RESX / 2 + img_loader_size - 1, DISPLAY_RESY / 2 + img_loader_size - 1 + yoffset);
     if (icon && memcmp(icon, "TOIg", 4) == 0 && LOADER_ICON_SIZE == *(uint16_t *)(icon + 4) && LOADER_ICON_SIZE == *(uint16_t *)(icon + 6) && iconlen == 12 + *(uint32_t *)(icon + 8)) {
         uint8_t icondata[LOADER_ICON_SIZE * LOADER_ICON_SIZE / 2];
         sinf_inflate(icon + 12, iconlen - 12, inflate_callback_loader, icondata);
@@ -468,6 +802,12 @@ void display_loader(uint16_t progress, int yoffset, uint16_t fgcolor, uint16_t b
             }
         }
     }
+    LOADER_VALID = 1;
+}
+
+uint32_t display_bytes_pushed(void)
+{
+    return DISPLAY_BYTES;
 }
 
 int *display_offset(int xy[2])
@@ -485,6 +825,7 @@ int display_orientation(int degrees)
         if (degrees == 0 || degrees == 90 || degrees == 180 || degrees == 270) {
             DISPLAY_ORIENTATION = degrees;
             display_set_orientation(degrees);
+            LOADER_VALID = 0;
         }
     }
     return DISPLAY_ORIENTATION;
@@ -22,7 +22,7 @@
 // provided by port
 
 int display_init(void);
-void display_refresh(void);
+int display_refresh(void);  // returns 1 if a new frame was presented
 void display_save(const char *filename);
 
 // provided by common
@@ -43,11 +43,14 @@ void display_text_center(int x, int y, const char *text, int textlen, uint8_t fo
 void display_text_right(int x, int y, const char *text, int textlen, uint8_t font, uint16_t fgcolor, uint16_t bgcolor);
 int display_text_width(const char *text, int textlen, uint8_t font);
 
+int display_qrcode_prepare(const char *data, int datalen, uint8_t *bitdata);
 void display_qrcode(int x, int y, const char *data, int datalen, uint8_t scale);
+void display_qrcode_bitmap(int x, int y, const uint8_t *bitdata, int side, uint8_t scale);
 void display_loader(uint16_t progress, int yoffset, uint16_t fgcolor, uint16_t bgcolor, const uint8_t *icon, uint32_t iconlen, uint16_t iconfgcolor);
 
 int *display_offset(int xy[2]);
 int display_orientation(int degrees);
 int display_backlight(int val);
+uint32_t display_bytes_pushed(void);
 
 #endif
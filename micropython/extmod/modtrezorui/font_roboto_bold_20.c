@@ -100,7 +100,105 @@
 /* } */ static const uint8_t Font_Roboto_Bold_20_glyph_125[] = { 7, 20, 7, 0, 16, 28, 80, 0, 4, 255, 112, 0, 7, 255, 32, 0, 31, 247, 0, 0, 255, 144, 0, 14, 249, 0, 0, 239, 144, 0, 13, 251, 0, 0, 143, 243, 0, 0, 207, 245, 0, 11, 255, 80, 8, 255, 64, 0, 223, 176, 0, 14, 249, 0, 0, 239, 144, 0, 15, 249, 0, 1, 255, 112, 0, 127, 242, 0, 79, 247, 0, 1, 197, 0, 0 };
 /* ~ */ static const uint8_t Font_Roboto_Bold_20_glyph_126[] = { 11, 5, 13, 1, 8, 6, 239, 195, 0, 42, 149, 255, 255, 246, 9, 252, 207, 198, 207, 255, 255, 109, 227, 0, 143, 255, 160, 0, 0, 0, 20, 32, 0 };
 
-const uint8_t * const Font_Roboto_Bold_20[126 + 1 - 32] = {
+static const uint16_t Font_Roboto_Bold_20_codepoints[95] = {
+    32,
+    33,
+    34,
+    35,
+    36,
+    37,
+    38,
+    39,
+    40,
+    41,
+    42,
+    43,
+    44,
+    45,
+    46,
+    47,
+    48,
+    49,
+    50,
+    51,
+    52,
+    53,
+    54,
+    55,
+    56,
+    57,
+    58,
+    59,
+    60,
+    61,
+    62,
+    63,
+    64,
+    65,
+    66,
+    67,
+    68,
+    69,
+    70,
+    71,
+    72,
+    73,
+    74,
+    75,
+    76,
+    77,
+    78,
+    79,
+    80,
+    81,
+    82,
+    83,
+    84,
+    85,
+    86,
+    87,
+    88,
+    89,
+    90,
+    91,
+    92,
+    93,
+    94,
+    95,
+    96,
+    97,
+    98,
+    99,
+    100,
+    101,
+    102,
+    103,
+    104,
+    105,
+    106,
+    107,
+    108,
+    109,
+    110,
+    111,
+    112,
+    113,
+    114,
+    115,
+    116,
+    117,
+    118,
+    119,
+    120,
+    121,
+    122,
+    123,
+    124,
+    125,
+    126,
+};
+
+static const uint8_t * const Font_Roboto_Bold_20_glyphs[95] = {
     Font_Roboto_Bold_20_glyph_32,
     Font_Roboto_Bold_20_glyph_33,
     Font_Roboto_Bold_20_glyph_34,
@@ -197,3 +295,10 @@ const uint8_t * const Font_Roboto_Bold_20[126 + 1 - 32] = {
     Font_Roboto_Bold_20_glyph_125,
     Font_Roboto_Bold_20_glyph_126,
 };
+
+const font_info Font_Roboto_Bold_20 = {
+    .count = 95,
+    .codepoints = Font_Roboto_Bold_20_codepoints,
+    .glyphs = Font_Roboto_Bold_20_glyphs,
+    .compressed = false,
+};
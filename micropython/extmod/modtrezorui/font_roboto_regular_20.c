@@ -100,7 +100,105 @@
 /* } */ static const uint8_t Font_Roboto_Regular_20_glyph_125[] = { 7, 20, 7, 0, 16, 122, 32, 0, 3, 222, 48, 0, 1, 252, 0, 0, 12, 240, 0, 0, 175, 32, 0, 10, 243, 0, 0, 159, 48, 0, 8, 245, 0, 0, 47, 194, 0, 0, 79, 244, 0, 12, 249, 16, 5, 247, 0, 0, 159, 48, 0, 10, 243, 0, 0, 175, 48, 0, 10, 242, 0, 0, 207, 0, 0, 47, 160, 0, 78, 226, 0, 6, 161, 0, 0 };
 /* ~ */ static const uint8_t Font_Roboto_Regular_20_glyph_126[] = { 12, 4, 14, 1, 8, 3, 207, 215, 0, 0, 181, 30, 234, 223, 195, 8, 243, 111, 48, 7, 255, 255, 160, 35, 0, 0, 39, 133, 0 };
 
-const uint8_t * const Font_Roboto_Regular_20[126 + 1 - 32] = {
+static const uint16_t Font_Roboto_Regular_20_codepoints[95] = {
+    32,
+    33,
+    34,
+    35,
+    36,
+    37,
+    38,
+    39,
+    40,
+    41,
+    42,
+    43,
+    44,
+    45,
+    46,
+    47,
+    48,
+    49,
+    50,
+    51,
+    52,
+    53,
+    54,
+    55,
+    56,
+    57,
+    58,
+    59,
+    60,
+    61,
+    62,
+    63,
+    64,
+    65,
+    66,
+    67,
+    68,
+    69,
+    70,
+    71,
+    72,
+    73,
+    74,
+    75,
+    76,
+    77,
+    78,
+    79,
+    80,
+    81,
+    82,
+    83,
+    84,
+    85,
+    86,
+    87,
+    88,
+    89,
+    90,
+    91,
+    92,
+    93,
+    94,
+    95,
+    96,
+    97,
+    98,
+    99,
+    100,
+    101,
+    102,
+    103,
+    104,
+    105,
+    106,
+    107,
+    108,
+    109,
+    110,
+    111,
+    112,
+    113,
+    114,
+    115,
+    116,
+    117,
+    118,
+    119,
+    120,
+    121,
+    122,
+    123,
+    124,
+    125,
+    126,
+};
+
+static const uint8_t * const Font_Roboto_Regular_20_glyphs[95] = {
     Font_Roboto_Regular_20_glyph_32,
     Font_Roboto_Regular_20_glyph_33,
     Font_Roboto_Regular_20_glyph_34,
@@ -197,3 +295,10 @@ const uint8_t * const Font_Roboto_Regular_20[126 + 1 - 32] = {
     Font_Roboto_Regular_20_glyph_125,
     Font_Roboto_Regular_20_glyph_126,
 };
+
+const font_info Font_Roboto_Regular_20 = {
+    .count = 95,
+    .codepoints = Font_Roboto_Regular_20_codepoints,
+    .glyphs = Font_Roboto_Regular_20_glyphs,
+    .compressed = false,
+};
@@ -1,3 +1,3 @@
-#include <stdint.h>
+#include "fonts.h"
 
-extern const uint8_t * const Font_Roboto_Regular_20[126 + 1 - 32];
+extern const font_info Font_Roboto_Regular_20;
@@ -100,7 +100,105 @@
 /* } */ static const uint8_t Font_RobotoMono_Regular_20_glyph_125[] = { 7, 20, 12, 3, 16, 68, 0, 0, 12, 251, 0, 0, 9, 246, 0, 0, 15, 192, 0, 0, 223, 0, 0, 12, 240, 0, 0, 207, 0, 0, 11, 242, 0, 0, 111, 128, 0, 0, 175, 182, 0, 3, 239, 192, 2, 253, 48, 0, 159, 64, 0, 11, 241, 0, 0, 207, 0, 0, 12, 240, 0, 0, 238, 0, 0, 95, 144, 0, 127, 242, 0, 10, 195, 0, 0 };
 /* ~ */ static const uint8_t Font_RobotoMono_Regular_20_glyph_126[] = { 12, 4, 12, 0, 8, 3, 223, 197, 0, 0, 115, 30, 216, 223, 144, 1, 245, 111, 16, 9, 253, 141, 224, 54, 0, 0, 93, 252, 32 };
 
-const uint8_t * const Font_RobotoMono_Regular_20[126 + 1 - 32] = {
+static const uint16_t Font_RobotoMono_Regular_20_codepoints[95] = {
+    32,
+    33,
+    34,
+    35,
+    36,
+    37,
+    38,
+    39,
+    40,
+    41,
+    42,
+    43,
+    44,
+    45,
+    46,
+    47,
+    48,
+    49,
+    50,
+    51,
+    52,
+    53,
+    54,
+    55,
+    56,
+    57,
+    58,
+    59,
+    60,
+    61,
+    62,
+    63,
+    64,
+    65,
+    66,
+    67,
+    68,
+    69,
+    70,
+    71,
+    72,
+    73,
+    74,
+    75,
+    76,
+    77,
+    78,
+    79,
+    80,
+    81,
+    82,
+    83,
+    84,
+    85,
+    86,
+    87,
+    88,
+    89,
+    90,
+    91,
+    92,
+    93,
+    94,
+    95,
+    96,
+    97,
+    98,
+    99,
+    100,
+    101,
+    102,
+    103,
+    104,
+    105,
+    106,
+    107,
+    108,
+    109,
+    110,
+    111,
+    112,
+    113,
+    114,
+    115,
+    116,
+    117,
+    118,
+    119,
+    120,
+    121,
+    122,
+    123,
+    124,
+    125,
+    126,
+};
+
+static const uint8_t * const Font_RobotoMono_Regular_20_glyphs[95] = {
     Font_RobotoMono_Regular_20_glyph_32,
     Font_RobotoMono_Regular_20_glyph_33,
     Font_RobotoMono_Regular_20_glyph_34,
@@ -197,3 +295,10 @@ const uint8_t * const Font_RobotoMono_Regular_20[126 + 1 - 32] = {
     Font_RobotoMono_Regular_20_glyph_125,
     Font_RobotoMono_Regular_20_glyph_126,
 };
+
+const font_info Font_RobotoMono_Regular_20 = {
+    .count = 95,
+    .codepoints = Font_RobotoMono_Regular_20_codepoints,
+    .glyphs = Font_RobotoMono_Regular_20_glyphs,
+    .compressed = false,
+};
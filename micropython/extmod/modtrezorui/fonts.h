@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Pavol Rusnak, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#ifndef __FONTS_H__
+#define __FONTS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// fonts are generated by tools/ttf2c
+//
+// each glyph starts with 5 bytes: width, height, advance, bearingX and
+// bearingY, followed by the bitmap, which is either packed 4-bit data or,
+// in compressed fonts, a packed stream of nibbles: each value nibble is
+// followed by a length - 1 nibble only if the value is 0 or 15 (runs of up
+// to 16 pixels), other values stand for a single pixel
+//
+// compressed glyphs are decoded through a cache in display.c, which is only
+// built in with TREZOR_FONT_COMPRESSED=1 (none of the fonts is compressed now)
+#ifndef TREZOR_FONT_COMPRESSED
+#define TREZOR_FONT_COMPRESSED 0
+#endif
+
+typedef struct {
+    uint16_t count;
+    const uint16_t *codepoints;         // sorted
+    const uint8_t * const *glyphs;
+    uint16_t kerning_count;
+    const uint32_t *kerning_pairs;      // left << 16 | right, sorted
+    const int8_t *kerning_values;
+    bool compressed;
+} font_info;
+
+#endif
@@ -65,3 +65,129 @@ static const uint16_t img_loader[64][64] = {
     {63090,63221,63221,63221,63221,63221,63221,63221,63221,63221,63221,62965,62965,62965,62965,62965,62965,62965,62965,62969,62975,62839,62720,62720,62464,62464,62464,62464,62464,62464,62464,62464,62208,62208,62208,62208,62208,61952,61952,61952,61952,61696,61696,61696,61440,61440,61184,61184,60928,60672,60416,60160,59904,59648,59136,58624,57856,56832,55552,53760,50432,44800,31744,0,},
     {63858,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63989,63994,63999,63863,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,63744,0,},
 };
+static const uint16_t img_loader_ring[1692] = {
+    63,319,575,831,1087,1343,1599,1855,2111,2367,2623,2879,3135,3391,3647,3903,
+    4159,4415,4671,4927,62,318,574,830,1086,1342,1598,1854,2110,2366,2622,2878,
+    3134,3390,3646,3902,4158,4414,4670,4926,61,317,573,829,1085,1341,1597,1853,
+    2109,2365,2621,2877,3133,3389,3645,3901,4157,4413,60,316,572,828,4669,4925,
+    1084,1340,1596,1852,2108,2364,2620,2876,3132,3388,3644,3900,59,315,571,827,
+    1083,1339,4156,4412,4668,4924,1595,1851,2107,2363,2619,58,314,570,2875,3131,
+    3387,3643,826,1082,1338,1594,3899,4155,4411,1850,2106,2362,2618,4667,4923,57,
+    313,569,825,2874,3130,3386,1081,1337,1593,1849,3642,3898,4154,56,312,2105,
+    2361,2617,4410,4666,4922,568,824,1080,2873,3129,3385,1336,1592,1848,3641,3897,
+    311,567,2104,2360,2616,4153,4409,823,1079,1335,2872,3128,4665,4921,310,1591,
+    1847,2103,3384,3640,3896,566,822,1078,2359,2615,4152,4408,1334,1590,2871,3127,
+    4664,309,565,1846,2102,3383,3639,4920,5176,821,1077,2358,2614,3895,4151,308,
+    1333,1589,2870,3126,4407,4663,564,820,1845,2101,3382,3638,4919,1076,1332,2357,
+    2613,3894,4150,5175,307,563,1588,1844,2869,3125,4406,819,1075,2100,2356,3381,
+    3637,4662,4918,306,1331,1587,2612,3893,5174,562,818,1843,2868,3124,4149,4405,
+    1074,1330,2099,2355,3380,4661,561,1586,2611,2867,3636,3892,4917,817,1073,1842,
+    2098,3123,4148,5173,1329,2354,3379,4404,560,816,1585,1841,2610,2866,3635,3891,
+    4660,4916,1072,2097,3122,4147,5172,559,1328,1584,2353,2609,3378,4403,815,1071,
+    1840,2865,3634,3890,4659,1327,2096,2352,3121,4146,4915,558,814,1583,2608,3377,
+    4402,5171,1070,1839,2095,2864,3633,3889,4658,5427,1326,1582,2351,3120,4145,4914,
+    813,1069,1838,2607,3376,4401,5170,1325,2094,2863,3632,4657,5426,812,1581,2350,
+    3119,3888,4144,4913,1068,1837,2606,3375,4400,5169,1324,2093,2862,3631,811,1067,
+    1580,1836,2349,2605,3118,3374,3887,4656,5425,1323,2092,2861,3630,4143,4912,1579,
+    2348,3117,3886,4399,5168,1066,1835,2604,3373,4655,5424,1322,1578,2091,2860,3629,
+    4142,4911,5680,1065,1834,2347,3116,3885,4398,5167,1321,2090,2603,3372,4141,4654,
+    5423,1064,1577,2346,2859,3628,4910,5679,1320,1833,2602,3115,3884,4397,5166,1576,
+    2089,2858,3371,4140,4653,5422,1832,2345,3114,3627,4909,1319,2088,2601,3883,4396,
+    5165,5678,1575,2344,2857,3370,4139,4652,1318,1831,2600,3113,3626,4908,5421,1574,
+    2087,3369,3882,4395,5164,5677,1830,2343,2856,3625,4138,4651,1573,2086,2599,3112,
+    4394,4907,5420,5933,1829,2342,2855,3368,3881,5676,2598,3111,3624,4137,4650,5163,
+    1572,2085,3367,3880,4393,4906,5419,5932,1828,2341,2854,5675,2084,2597,3110,3623,
+    4136,4649,5162,1827,2340,2853,3366,3879,4392,4905,5418,5931,2083,2596,3109,3622,
+    4135,4648,5161,1826,2339,2852,5674,6187,2082,3365,3878,4391,4904,5417,5930,2595,
+    3108,3621,4134,4647,5160,2338,2851,3364,3877,4390,5673,6186,2081,2594,3107,3620,
+    4903,5416,5929,2337,2850,3363,4133,4646,5159,2080,2593,3106,3876,4389,4902,5672,
+    6185,2336,2849,3619,4132,5415,5928,2592,3362,3875,4645,5158,5671,6441,2335,3105,
+    3618,4388,4901,6184,2848,3361,4131,4644,5414,5927,2334,2591,3104,3874,4387,5157,
+    5670,6440,2847,3360,3617,4130,4900,5413,6183,2590,3103,3873,4643,5156,5926,6696,
+    2846,3616,4386,4899,5669,6439,2589,3359,3872,4129,4642,5412,6182,2845,3102,3615,
+    4385,5155,5925,6695,3358,4128,4898,5668,6438,2844,3101,3614,3871,4641,5411,6181,
+    3357,4127,4384,4897,5154,5667,5924,6694,2843,3100,3870,4640,5410,6180,6437,3356,
+    3613,4383,5153,5923,6950,3099,3869,4126,4639,4896,5666,6436,6693,3355,3612,4382,
+    5409,6179,3098,3868,4125,4895,5152,5922,6692,6949,3354,3611,4381,4638,5408,5665,
+    6435,4124,5151,6178,7205,3610,3867,4637,4894,5664,5921,6691,6948,3353,4123,4380,
+    5150,5407,6177,6434,3609,3866,4636,4893,5920,6947,7204,3352,4122,4379,5406,5663,
+    6433,6690,3608,3865,4635,4892,5149,5919,6176,7203,4121,4378,5405,5662,6689,6946,
+    3607,3864,4891,5148,6175,6432,4120,4377,4634,5661,5918,7202,7459,3863,4890,5147,
+    5404,6431,6688,6945,4119,4376,4633,5917,6174,7458,3862,4889,5146,5403,5660,6944,
+    7201,4118,4375,4632,5916,6173,6430,6687,4888,5145,5402,5659,7200,7457,7714,4117,
+    4374,4631,6172,6429,6686,6943,4887,5144,5401,5658,5915,7713,4373,4630,6428,6685,
+    6942,7199,7456,4886,5143,5400,5657,5914,6171,4372,4629,6941,7198,7455,7712,7969,
+    4628,4885,5142,5399,5656,5913,6170,6427,6684,7968,4627,4884,5141,5398,5655,5912,
+    6169,6426,6683,6940,7197,7454,7711,4883,5140,5397,5654,5911,6168,6425,6682,6939,
+    7196,7453,7710,7967,8224,4882,5139,5396,5653,5910,6167,6424,6681,6938,7195,7452,
+    7709,7966,8223,5138,5395,5652,5909,6166,6423,6680,6937,7194,5137,5394,7451,7708,
+    7965,8222,8479,5651,5908,6165,6422,6679,6936,5393,5650,7193,7450,7707,7964,8221,
+    5907,6164,6421,6678,6935,8478,5392,5649,5906,7192,7449,7706,7963,6163,6420,6677,
+    6934,8220,8477,8734,5648,5905,6162,7191,7448,7705,7962,5647,6419,6676,6933,7190,
+    8219,8476,5904,6161,6418,7447,7704,8733,5903,6675,6932,7189,7961,8218,8475,6160,
+    6417,6674,7446,7703,8732,8989,5902,6159,6931,7188,7960,8217,6416,6673,7445,7702,
+    8474,8731,6158,6415,6930,7187,7444,7959,8216,8988,6157,6672,6929,7701,7958,8473,
+    8730,6414,6671,7186,7443,8215,8987,9244,6413,6928,7185,7700,7957,8472,8729,6670,
+    6927,7442,7699,8214,8471,8986,9243,7184,7956,8728,9500,6669,6926,7441,7698,8213,
+    8470,8985,6668,7183,7440,7955,8212,8727,9242,9499,6925,7182,7697,8469,8984,6924,
+    7439,7696,7954,8211,8726,9241,9498,7181,7438,7953,8468,8983,9755,6923,7180,7695,
+    8210,8725,9240,9497,7437,7952,8209,8467,8724,8982,9239,9754,7179,7436,7694,7951,
+    8466,8981,9496,7693,8208,8723,9238,9753,7435,7692,7950,8465,8980,9495,10010,7434,
+    7949,8207,8464,8722,9237,9752,7691,8206,8721,8979,9494,10009,7690,7948,8463,8978,
+    9236,9751,10266,7947,8205,8462,8720,9235,9493,10008,7689,7946,8204,8719,8977,9492,
+    9750,10265,8203,8461,8976,9234,9749,10007,7945,8460,8718,9233,9491,10264,8202,8717,
+    8975,9490,9748,10006,10521,8201,8459,8974,9232,10005,10263,8200,8458,8716,9231,9489,
+    9747,10262,10520,8457,8715,8973,9488,9746,10004,8456,8714,8972,9230,10003,10261,10519,
+    8713,8971,9229,9487,9745,10518,10776,8970,9228,9486,9744,10002,10260,8712,9485,9743,
+    10001,10259,10517,10775,8711,8969,9227,10774,11032,8968,9226,9484,9742,10000,10258,10516,
+    8967,9225,9483,9741,9999,10257,10515,10773,11031,9224,9482,9740,9998,10256,10514,10772,
+    9223,9481,9739,11030,9222,9480,9997,10255,10513,10771,11029,11287,9738,9996,10254,10512,
+    10770,11028,9479,9737,9995,10253,10511,11286,9478,9736,9994,10252,10769,11027,11285,11543,
+    9735,9993,10251,10510,10768,11026,9734,9992,10509,10767,11025,11284,11542,9733,9991,10250,
+    10508,10766,11283,11541,9990,10249,10507,10765,11024,11282,9989,10248,10506,11023,11281,11540,
+    11798,10247,10505,10764,11022,11539,10246,10504,10763,11021,11280,11538,11797,10245,10503,10762,
+    11020,11279,11537,11796,10244,10502,10761,11019,11278,11795,12054,10501,10760,11018,11277,11536,
+    11794,12053,10500,10759,11017,11276,11535,11793,12052,10757,10758,11016,11275,11534,11792,12051,
+    12310,10756,11015,11274,11533,12050,12309,11014,11273,11532,11791,12049,12308,11013,11272,11531,
+    11790,12048,12307,11011,11012,11270,11271,11529,11530,11788,11789,12047,12306,12565,11269,11528,
+    11787,12046,11268,11527,11786,12045,12305,12564,11267,11526,11785,12044,12303,12304,12563,11525,
+    11784,12043,12302,12562,12821,11523,11524,11783,12042,12301,12561,12820,11781,11782,12041,12300,
+    12560,12819,11780,12039,12040,12299,12558,12559,12818,13077,11778,11779,12038,12298,12557,12817,
+    13076,12037,12296,12297,12556,12816,13075,12035,12036,12295,12555,12814,12815,13074,12034,12293,
+    12294,12553,12554,12813,13073,12292,12552,12812,13072,13332,12290,12291,12550,12551,12810,12811,
+    13070,13071,13330,13331,12549,12809,13069,13329,12547,12548,12807,12808,13068,13328,13588,12546,
+    12806,13066,13067,13326,13327,13587,12804,12805,13064,13065,13325,13586,12802,12803,13063,13323,
+    13324,13584,13585,12801,13061,13062,13322,13583,13844,13059,13060,13320,13321,13581,13582,13842,
+    13843,13057,13058,13318,13319,13579,13580,13841,13316,13317,13577,13578,13839,13840,14100,13314,
+    13315,13575,13576,13837,13838,14099,13313,13573,13574,13835,13836,14097,14098,13571,13572,13833,
+    13834,14095,14096,13569,13570,13831,13832,14093,14094,14355,14356,13829,13830,14091,14092,14354,
+    13826,13827,13828,14089,14090,14352,14353,13825,14086,14087,14088,14349,14350,14351,14083,14084,
+    14085,14347,14348,14610,14611,14081,14082,14344,14345,14346,14608,14609,14341,14342,14343,14606,
+    14607,14338,14339,14340,14603,14604,14605,14336,14337,14600,14601,14602,14865,14866,14867,14596,
+    14597,14598,14599,14862,14863,14864,14592,14593,14594,14595,14859,14860,14861,14855,14856,14857,
+    14858,15122,15123,14851,14852,14853,14854,15119,15120,15121,14848,14849,14850,15115,15116,15117,
+    15118,15110,15111,15112,15113,15114,15104,15105,15106,15107,15108,15109,15376,15377,15378,15379,
+    15371,15372,15373,15374,15375,15364,15365,15366,15367,15368,15369,15370,15360,15361,15362,15363,
+    15634,15635,15627,15628,15629,15630,15631,15632,15633,15616,15617,15618,15619,15620,15621,15622,
+    15623,15624,15625,15626,15883,15884,15885,15886,15887,15888,15889,15890,15891,15872,15873,15874,
+    15875,15876,15877,15878,15879,15880,15881,15882,16128,16129,16130,16131,16132,16133,16134,16135,
+    16136,16137,16138,16139,16140,16141,16142,16143,16144,16145,16146,16147,
+};
+static const uint16_t img_loader_ring_index[251] = {
+    0,20,20,31,40,40,51,58,64,71,76,86,91,98,105,111,
+    118,125,133,139,144,151,158,165,172,177,185,191,198,205,212,219,
+    227,233,240,246,253,260,264,274,279,286,293,299,306,314,320,327,
+    333,340,346,350,361,367,373,379,387,394,401,408,415,422,427,434,
+    440,447,454,460,468,474,480,488,492,499,508,515,520,527,533,540,
+    547,553,561,567,574,580,586,594,601,608,614,621,628,633,640,648,
+    655,661,669,674,682,689,693,701,708,715,722,730,736,742,749,756,
+    762,769,776,783,790,796,803,809,816,825,826,839,839,853,853,866,
+    867,876,883,889,896,902,909,916,923,930,936,943,950,956,962,970,
+    977,984,991,999,1003,1010,1018,1023,1031,1037,1044,1052,1059,1064,1071,1078,
+    1084,1091,1098,1106,1112,1118,1125,1131,1139,1145,1152,1159,1165,1172,1177,1184,
+    1193,1200,1204,1212,1218,1224,1232,1238,1245,1252,1258,1265,1270,1277,1284,1291,
+    1298,1305,1313,1319,1325,1331,1342,1346,1352,1359,1365,1372,1378,1386,1393,1399,
+    1406,1413,1418,1428,1432,1439,1446,1452,1459,1465,1473,1480,1487,1494,1501,1507,
+    1515,1520,1527,1534,1541,1548,1553,1559,1567,1574,1581,1587,1594,1601,1606,1616,
+    1621,1628,1634,1641,1652,1652,1661,1672,1672,1672,1692,
+};
@@ -5,6 +5,10 @@ import sys
 outer = 64
 inner = 42
 
+# pixels of the ring (where foreground and background shades differ),
+# sorted by angle so that a change of progress can be repainted alone
+ring = []
+
 with open('loader.h', 'wt') as f:
     f.write('static const int img_loader_size = %d;\n' % outer)
     f.write('static const uint16_t img_loader[%d][%d] = {\n' % (outer, outer))
@@ -31,5 +35,18 @@ with open('loader.h', 'wt') as f:
             a = int(math.atan2((outer - 1 - x), (outer - 1 - y)) * 2 * 249 / math.pi)
             v = (a << 8) | (c[15] << 4) | c[5]
             f.write('%d,' % v)
+            if c[15] != c[5]:
+                ring.append((a, y, x))
         f.write('},\n')
     f.write('};\n')
+    ring.sort()
+    f.write('static const uint16_t img_loader_ring[%d] = {\n' % len(ring))
+    for i in range(0, len(ring), 16):
+        f.write('    %s,\n' % ','.join(['%d' % ((y << 8) | x) for a, y, x in ring[i:i + 16]]))
+    f.write('};\n')
+    # img_loader_ring_index[a] is the first pixel of the ring with angle >= a
+    f.write('static const uint16_t img_loader_ring_index[%d] = {\n' % 251)
+    index = [sum(1 for r in ring if r[0] < a) for a in range(251)]
+    for i in range(0, len(index), 16):
+        f.write('    %s,\n' % ','.join(['%d' % v for v in index[i:i + 16]]))
+    f.write('};\n')
@@ -8,6 +8,7 @@
 #include "inflate.h"
 
 #include "display.h"
+#include "trezor-qrenc/qr_encode.h"
 
 typedef struct _mp_obj_Display_t {
     mp_obj_base_t base;
@@ -31,13 +32,13 @@ STATIC mp_obj_t mod_TrezorUi_Display_clear(mp_obj_t self) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorUi_Display_clear_obj, mod_TrezorUi_Display_clear);
 
-/// def trezor.ui.display.refresh() -> None
+/// def trezor.ui.display.refresh() -> bool
 ///     '''
 ///     Refresh display (update screen)
+///     Returns True if a new frame was presented.
 ///     '''
 STATIC mp_obj_t mod_TrezorUi_Display_refresh(mp_obj_t self) {
-    display_refresh();
-    return mp_const_none;
+    return display_refresh() ? mp_const_true : mp_const_false;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_TrezorUi_Display_refresh_obj, mod_TrezorUi_Display_refresh);
 
@@ -240,12 +241,57 @@ STATIC mp_obj_t mod_TrezorUi_Display_qrcode(size_t n_args, const mp_obj_t *args)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_TrezorUi_Display_qrcode_obj, 5, 5, mod_TrezorUi_Display_qrcode);
 
+/// def trezor.ui.display.qrcode_prepare(data: bytes) -> bytes:
+///     '''
+///     Encodes data as a QR code and returns its bitmap for qrcode_bitmap.
+///     First byte is the side of the code in modules, the rest are the modules.
+///     '''
+STATIC mp_obj_t mod_TrezorUi_Display_qrcode_prepare(mp_obj_t self, mp_obj_t data) {
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(data, &buf, MP_BUFFER_READ);
+    if (buf.len == 0) {
+        mp_raise_ValueError("Empty data");
+    }
+    uint8_t bitdata[1 + QR_MAX_BITDATA];
+    int side = display_qrcode_prepare(buf.buf, buf.len, bitdata + 1);
+    if (side <= 0) {
+        mp_raise_ValueError("Cannot encode data");
+    }
+    bitdata[0] = side;
+    return mp_obj_new_bytes(bitdata, 1 + (side * side + 7) / 8);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_TrezorUi_Display_qrcode_prepare_obj, mod_TrezorUi_Display_qrcode_prepare);
+
+/// def trezor.ui.display.qrcode_bitmap(x: int, y: int, bitmap: bytes, scale: int) -> None:
+///     '''
+///     Renders a QR code bitmap returned by qrcode_prepare centered at position (x,y).
+///     Scale determines a zoom factor.
+///     '''
+STATIC mp_obj_t mod_TrezorUi_Display_qrcode_bitmap(size_t n_args, const mp_obj_t *args) {
+    mp_int_t x = mp_obj_get_int(args[1]);
+    mp_int_t y = mp_obj_get_int(args[2]);
+    mp_int_t scale = mp_obj_get_int(args[4]);
+    if (scale < 1 || scale > 10) {
+        mp_raise_ValueError("Scale has to be between 1 and 10");
+    }
+    mp_buffer_info_t bitmap;
+    mp_get_buffer_raise(args[3], &bitmap, MP_BUFFER_READ);
+    const uint8_t *data = bitmap.buf;
+    if (bitmap.len < 1 || bitmap.len < 1 + (data[0] * data[0] + 7) / 8) {
+        mp_raise_ValueError("Invalid QR code bitmap");
+    }
+    display_qrcode_bitmap(x, y, data + 1, data[0], scale);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_TrezorUi_Display_qrcode_bitmap_obj, 5, 5, mod_TrezorUi_Display_qrcode_bitmap);
+
 /// def trezor.ui.display.loader(progress: int, yoffset: int, fgcolor: int, bgcolor: int, icon: bytes=None, iconfgcolor: int=None) -> None:
 ///     '''
 ///     Renders a rotating loader graphic.
 ///     Progress determines its position (0-1000), fgcolor is used as foreground color, bgcolor as background.
 ///     When icon and iconfgcolor are provided, an icon is drawn in the middle using the color specified in iconfgcolor.
 ///     Icon needs to be of exactly LOADER_ICON_SIZE x LOADER_ICON_SIZE pixels size.
+///     When only progress changed since the previous call, just the affected part of the ring is repainted.
 ///     '''
 STATIC mp_obj_t mod_TrezorUi_Display_loader(size_t n_args, const mp_obj_t *args) {
     mp_int_t progress = mp_obj_get_int(args[1]);
@@ -358,6 +404,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_TrezorUi_Display_offset_obj, 1, 2
 /// def trezor.ui.display.save(filename: string) -> None:
 ///     '''
 ///     Saves current display contents to file filename.
+///     Writes a PNG image, or raw RGB565 pixels when filename ends with .raw.
 ///     '''
 STATIC mp_obj_t mod_TrezorUi_Display_save(mp_obj_t self, mp_obj_t filename) {
     mp_buffer_info_t fn;
@@ -382,6 +429,8 @@ STATIC const mp_rom_map_elem_t mod_TrezorUi_Display_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_text_right), MP_ROM_PTR(&mod_TrezorUi_Display_text_right_obj) },
     { MP_ROM_QSTR(MP_QSTR_text_width), MP_ROM_PTR(&mod_TrezorUi_Display_text_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_qrcode), MP_ROM_PTR(&mod_TrezorUi_Display_qrcode_obj) },
+    { MP_ROM_QSTR(MP_QSTR_qrcode_prepare), MP_ROM_PTR(&mod_TrezorUi_Display_qrcode_prepare_obj) },
+    { MP_ROM_QSTR(MP_QSTR_qrcode_bitmap), MP_ROM_PTR(&mod_TrezorUi_Display_qrcode_bitmap_obj) },
     { MP_ROM_QSTR(MP_QSTR_loader), MP_ROM_PTR(&mod_TrezorUi_Display_loader_obj) },
     { MP_ROM_QSTR(MP_QSTR_orientation), MP_ROM_PTR(&mod_TrezorUi_Display_orientation_obj) },
     { MP_ROM_QSTR(MP_QSTR_backlight), MP_ROM_PTR(&mod_TrezorUi_Display_backlight_obj) },
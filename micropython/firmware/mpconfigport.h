@@ -106,6 +106,8 @@
 #define MICROPY_PY_TREZORCRYPTO     (1)
 #define MICROPY_PY_TREZORDEBUG      (1)
 #define MICROPY_PY_TREZORMSG        (1)
+#define MICROPY_PY_TREZORRES        (1)
+#define MICROPY_PY_TREZORTELEMETRY  (1)
 #define MICROPY_PY_TREZORUI         (1)
 #define MICROPY_PY_TREZORUTILS      (1)
 
@@ -153,6 +155,8 @@ extern const struct _mp_obj_module_t mp_module_TrezorConfig;
 extern const struct _mp_obj_module_t mp_module_TrezorCrypto;
 extern const struct _mp_obj_module_t mp_module_TrezorDebug;
 extern const struct _mp_obj_module_t mp_module_TrezorMsg;
+extern const struct _mp_obj_module_t mp_module_TrezorRes;
+extern const struct _mp_obj_module_t mp_module_TrezorTelemetry;
 extern const struct _mp_obj_module_t mp_module_TrezorUi;
 extern const struct _mp_obj_module_t mp_module_TrezorUtils;
 #define MICROPY_PORT_BUILTIN_MODULES \
@@ -161,6 +165,8 @@ extern const struct _mp_obj_module_t mp_module_TrezorUtils;
     { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorCrypto), (mp_obj_t)&mp_module_TrezorCrypto }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorDebug), (mp_obj_t)&mp_module_TrezorDebug }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorMsg), (mp_obj_t)&mp_module_TrezorMsg }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorRes), (mp_obj_t)&mp_module_TrezorRes }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorTelemetry), (mp_obj_t)&mp_module_TrezorTelemetry }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorUi), (mp_obj_t)&mp_module_TrezorUi }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR_TrezorUtils), (mp_obj_t)&mp_module_TrezorUtils },
 
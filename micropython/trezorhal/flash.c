@@ -1,5 +1,18 @@
 #include STM32_HAL_H
 
+#include "flash.h"
+
+// STM32F405: 4 x 16 KiB, 1 x 64 KiB, 7 x 128 KiB
+static const uint32_t FLASH_SECTOR_TABLE[FLASH_SECTOR_COUNT + 1] = {
+    0x08000000, 0x08004000, 0x08008000, 0x0800C000,
+    0x08010000, 0x08020000, 0x08040000, 0x08060000,
+    0x08080000, 0x080A0000, 0x080C0000, 0x080E0000,
+    0x08100000, // last element - not a valid sector
+};
+
+// same as FLASH_TIMEOUT_VALUE in the HAL (ms)
+#define FLASH_WRITE_TIMEOUT 50000
+
 int flash_init(void)
 {
     return 0;
@@ -38,3 +51,69 @@ void flash_set_option_bytes(void)
         HAL_FLASHEx_OBProgram(&opts);
     }
 }
+
+bool flash_unlock(void)
+{
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                           FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+    return true;
+}
+
+bool flash_lock(void)
+{
+    HAL_FLASH_Lock();
+    return true;
+}
+
+uint32_t flash_sector_address(uint8_t sector)
+{
+    if (sector >= FLASH_SECTOR_COUNT) {
+        return 0;
+    }
+    return FLASH_SECTOR_TABLE[sector];
+}
+
+int flash_sector_of(uint32_t address)
+{
+    for (int i = 0; i < FLASH_SECTOR_COUNT; i++) {
+        if (address >= FLASH_SECTOR_TABLE[i] && address < FLASH_SECTOR_TABLE[i + 1]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool flash_erase_sector(uint8_t sector)
+{
+    FLASH_EraseInitTypeDef EraseInitStruct;
+    EraseInitStruct.TypeErase = FLASH_TYPEERASE_SECTORS;
+    EraseInitStruct.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    EraseInitStruct.Sector = sector;
+    EraseInitStruct.NbSectors = 1;
+    uint32_t SectorError = 0;
+    return HAL_FLASHEx_Erase(&EraseInitStruct, &SectorError) == HAL_OK;
+}
+
+bool flash_write_word(uint32_t address, uint32_t data)
+{
+    return HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, data) == HAL_OK;
+}
+
+bool flash_write_words(uint32_t address, const uint32_t *data, uint32_t count)
+{
+    // a write to the flash stalls the bus until the previous word has been
+    // programmed, so the status needs to be checked only after the last one
+    if (FLASH_WaitForLastOperation(FLASH_WRITE_TIMEOUT) != HAL_OK) {
+        return false;
+    }
+    FLASH->CR &= CR_PSIZE_MASK;
+    FLASH->CR |= FLASH_PSIZE_WORD;
+    FLASH->CR |= FLASH_CR_PG;
+    for (uint32_t i = 0; i < count; i++) {
+        ((__IO uint32_t *)address)[i] = data[i];
+    }
+    HAL_StatusTypeDef status = FLASH_WaitForLastOperation(FLASH_WRITE_TIMEOUT);
+    FLASH->CR &= ~FLASH_CR_PG;
+    return status == HAL_OK;
+}
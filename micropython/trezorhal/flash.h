@@ -1,8 +1,25 @@
 #ifndef __TREZORHAL_FLASH_H__
 #define __TREZORHAL_FLASH_H__
 
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLASH_SECTOR_COUNT 12
+
 int flash_init(void);
 
 void flash_set_option_bytes(void);
 
+bool flash_unlock(void);
+bool flash_lock(void);
+
+// returns the start address of the sector
+uint32_t flash_sector_address(uint8_t sector);
+// returns the sector containing the address or -1 if outside of the flash
+int flash_sector_of(uint32_t address);
+
+bool flash_erase_sector(uint8_t sector);
+bool flash_write_word(uint32_t address, uint32_t data);
+bool flash_write_words(uint32_t address, const uint32_t *data, uint32_t count);
+
 #endif
@@ -1,9 +1,9 @@
 #include <string.h>
 
-#include "blake2s.h"
 #include "ed25519-donna/ed25519.h"
 
 #include "common.h"
+#include "display.h"
 #include "image.h"
 
 static const uint8_t * const SATOSHILABS_PUBKEYS[] = {
@@ -14,6 +14,49 @@ static const uint8_t * const SATOSHILABS_PUBKEYS[] = {
     (const uint8_t *)"\x63\x55\x69\x1c\x17\x8a\x8f\xf9\x10\x07\xa7\x47\x8a\xfb\x95\x5e\xf7\x35\x2c\x63\xe7\xb2\x57\x03\x98\x4c\xf7\x8b\x26\xe2\x1a\x56",
 };
 
+#define SIGAREA_SIZE 65
+
+static const uint8_t SIGAREA_ZEROES[SIGAREA_SIZE] = {0};
+
+void image_hash_init(image_hash_ctx *ctx, uint32_t hdrlen)
+{
+    blake2s_Init(&ctx->ctx, BLAKE2S_DIGEST_LENGTH);
+    ctx->pos = 0;
+    ctx->sigpos = hdrlen - SIGAREA_SIZE;
+}
+
+void image_hash_update(image_hash_ctx *ctx, const uint8_t *data, uint32_t len)
+{
+    // data in front of the signature area
+    if (ctx->pos < ctx->sigpos && len > 0) {
+        uint32_t n = ctx->sigpos - ctx->pos;
+        if (n > len) n = len;
+        blake2s_Update(&ctx->ctx, data, n);
+        ctx->pos += n;
+        data += n;
+        len -= n;
+    }
+    // signature area, hashed as zeroes
+    if (ctx->pos < ctx->sigpos + SIGAREA_SIZE && len > 0) {
+        uint32_t n = ctx->sigpos + SIGAREA_SIZE - ctx->pos;
+        if (n > len) n = len;
+        blake2s_Update(&ctx->ctx, SIGAREA_ZEROES, n);
+        ctx->pos += n;
+        data += n;
+        len -= n;
+    }
+    // everything after the signature area
+    if (len > 0) {
+        blake2s_Update(&ctx->ctx, data, len);
+        ctx->pos += len;
+    }
+}
+
+void image_hash_final(image_hash_ctx *ctx, uint8_t hash[BLAKE2S_DIGEST_LENGTH])
+{
+    blake2s_Final(&ctx->ctx, hash, BLAKE2S_DIGEST_LENGTH);
+}
+
 static bool compute_pubkey(const vendor_header *vhdr, uint8_t sigmask, ed25519_public_key res)
 {
     uint8_t vsig_m;
@@ -83,24 +126,38 @@ bool image_parse_header(const uint8_t *data, uint32_t magic, uint32_t maxsize, i
     return true;
 }
 
-bool image_check_signature(const uint8_t *data, const image_header *hdr, const vendor_header *vhdr)
+bool image_check_hash(const uint8_t hash[BLAKE2S_DIGEST_LENGTH], const image_header *hdr, const vendor_header *vhdr)
 {
-    uint8_t hash[BLAKE2S_DIGEST_LENGTH];
-    BLAKE2S_CTX ctx;
-    blake2s_Init(&ctx, BLAKE2S_DIGEST_LENGTH);
-    blake2s_Update(&ctx, data, HEADER_SIZE - 65);
-    for (int i = 0; i < 65; i++) {
-        blake2s_Update(&ctx, (const uint8_t *)"\x00", 1);
-    }
-    blake2s_Update(&ctx, data + HEADER_SIZE, hdr->codelen);
-    blake2s_Final(&ctx, hash, BLAKE2S_DIGEST_LENGTH);
-
     ed25519_public_key pub;
     if (!compute_pubkey(vhdr, hdr->sigmask, pub)) return false;
 
     return 0 == ed25519_sign_open(hash, BLAKE2S_DIGEST_LENGTH, pub, *(const ed25519_signature *)hdr->sig);
 }
 
+void image_progress_bar(uint32_t done, uint32_t total)
+{
+    display_bar(0, DISPLAY_RESY - 2, DISPLAY_RESX * done / total, 2, 0xFFFF);
+}
+
+bool image_check_signature(const uint8_t *data, const image_header *hdr, const vendor_header *vhdr, image_progress_callback progress)
+{
+    const uint32_t total = HEADER_SIZE + hdr->codelen;
+    image_hash_ctx ctx;
+    image_hash_init(&ctx, HEADER_SIZE);
+    for (uint32_t pos = 0; pos < total; pos += IMAGE_CHUNK_SIZE) {
+        uint32_t n = total - pos;
+        if (n > IMAGE_CHUNK_SIZE) n = IMAGE_CHUNK_SIZE;
+        image_hash_update(&ctx, data + pos, n);
+        if (progress) {
+            progress(pos + n, total);
+        }
+    }
+    uint8_t hash[BLAKE2S_DIGEST_LENGTH];
+    image_hash_final(&ctx, hash);
+
+    return image_check_hash(hash, hdr, vhdr);
+}
+
 bool vendor_parse_header(const uint8_t *data, vendor_header *vhdr)
 {
     if (!vhdr) {
@@ -152,13 +209,10 @@ bool vendor_parse_header(const uint8_t *data, vendor_header *vhdr)
 bool vendor_check_signature(const uint8_t *data, const vendor_header *vhdr)
 {
     uint8_t hash[BLAKE2S_DIGEST_LENGTH];
-    BLAKE2S_CTX ctx;
-    blake2s_Init(&ctx, BLAKE2S_DIGEST_LENGTH);
-    blake2s_Update(&ctx, data, vhdr->hdrlen - 65);
-    for (int i = 0; i < 65; i++) {
-        blake2s_Update(&ctx, (const uint8_t *)"\x00", 1);
-    }
-    blake2s_Final(&ctx, hash, BLAKE2S_DIGEST_LENGTH);
+    image_hash_ctx ctx;
+    image_hash_init(&ctx, vhdr->hdrlen);
+    image_hash_update(&ctx, data, vhdr->hdrlen);
+    image_hash_final(&ctx, hash);
 
     ed25519_public_key pub;
     if (!compute_pubkey(NULL, vhdr->sigmask, pub)) return false;
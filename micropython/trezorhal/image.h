@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "blake2s.h"
+
 typedef struct {
     uint32_t magic;
     uint32_t hdrlen;
@@ -32,9 +34,34 @@ typedef struct {
     uint8_t sig[64];
 } vendor_header;
 
+// images are hashed in chunks of this size when checking their signature
+#define IMAGE_CHUNK_SIZE (16 * 1024)
+
+// called after each hashed chunk with the number of bytes done so far
+typedef void (*image_progress_callback)(uint32_t done, uint32_t total);
+
+// progress callback drawing a bar at the bottom of the screen
+void image_progress_bar(uint32_t done, uint32_t total);
+
+// incremental hash of an image, the signature area (sigmask + signature,
+// the last 65 bytes of the header) is replaced with zeroes on the fly
+typedef struct {
+    BLAKE2S_CTX ctx;
+    uint32_t pos;
+    uint32_t sigpos;
+} image_hash_ctx;
+
+void image_hash_init(image_hash_ctx *ctx, uint32_t hdrlen);
+
+void image_hash_update(image_hash_ctx *ctx, const uint8_t *data, uint32_t len);
+
+void image_hash_final(image_hash_ctx *ctx, uint8_t hash[BLAKE2S_DIGEST_LENGTH]);
+
 bool image_parse_header(const uint8_t *data, uint32_t magic, uint32_t maxsize, image_header *hdr);
 
-bool image_check_signature(const uint8_t *data, const image_header *hdr, const vendor_header *vhdr);
+bool image_check_hash(const uint8_t hash[BLAKE2S_DIGEST_LENGTH], const image_header *hdr, const vendor_header *vhdr);
+
+bool image_check_signature(const uint8_t *data, const image_header *hdr, const vendor_header *vhdr, image_progress_callback progress);
 
 bool vendor_parse_header(const uint8_t *data, vendor_header *vhdr);
 
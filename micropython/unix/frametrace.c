@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Pavol Rusnak, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "py/bc.h"
+#include "py/qstr.h"
+
+#include "frametrace.h"
+
+// Python frame enter/exit events of the VM, kept in a ring buffer and
+// written at exit to the file named by TREZOR_FRAMETRACE, one event per line:
+//
+//   E <time us> <function> <source file> <line>
+//   X <time us>
+//
+// see tools/frametrace-collapse for conversion to the stackcollapse format
+//
+// the VM only has a hook for a normal return, so frames left by yield or by
+// an exception are detected from the C stack: frames of mp_execute_bytecode
+// deeper than (or as deep as) the currently running one have already exited
+
+#define EVENTS (1 << 21)
+#define DEPTH  256
+
+typedef struct {
+    uint32_t time;
+    uint16_t name; // 0 marks an exit
+    uint16_t file;
+    uint32_t line;
+} event_t;
+
+static event_t *EVENT;
+static uint32_t EVENT_POS, EVENT_COUNT;
+static int ENABLED = -1;
+static const char *PATH;
+
+static struct {
+    const void *frame;
+    const void *fun;
+} STACK[DEPTH];
+static int STACK_TOP;
+
+static uint32_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static event_t *event_add(uint32_t t)
+{
+    event_t *e = &EVENT[EVENT_POS];
+    EVENT_POS = (EVENT_POS + 1) % EVENTS;
+    if (EVENT_COUNT < EVENTS) {
+        EVENT_COUNT++;
+    }
+    e->time = t;
+    return e;
+}
+
+static void frametrace_dump(void)
+{
+    FILE *f = fopen(PATH, "wt");
+    if (!f) {
+        return;
+    }
+    // frames still running when the trace ends
+    const uint32_t t = now_us();
+    for (int i = 0; i < STACK_TOP; i++) {
+        event_add(t)->name = 0;
+    }
+    for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+        const event_t *e = &EVENT[(EVENT_POS + EVENTS - EVENT_COUNT + i) % EVENTS];
+        if (e->name) {
+            fprintf(f, "E %u %s %s %u\n", e->time, qstr_str(e->name), qstr_str(e->file), e->line);
+        } else {
+            fprintf(f, "X %u\n", e->time);
+        }
+    }
+    fclose(f);
+}
+
+static int frametrace_enabled(void)
+{
+    if (ENABLED < 0) {
+        PATH = getenv("TREZOR_FRAMETRACE");
+        EVENT = PATH ? calloc(EVENTS, sizeof(event_t)) : NULL;
+        ENABLED = EVENT != NULL;
+        if (ENABLED) {
+            atexit(frametrace_dump);
+        }
+    }
+    return ENABLED;
+}
+
+// the C stack grows down, deeper frames have lower addresses
+static void pop_below(const void *frame, uint32_t t)
+{
+    while (STACK_TOP > 0 && STACK[STACK_TOP - 1].frame < frame) {
+        STACK_TOP--;
+        event_add(t)->name = 0;
+    }
+}
+
+// same as vm.c does for tracebacks, the line is the one of the first
+// statement of the function
+static void code_state_info(const mp_code_state_t *code_state, event_t *e)
+{
+    const byte *ip = code_state->fun_bc->bytecode;
+    mp_decode_uint(&ip); // skip n_state
+    mp_decode_uint(&ip); // skip n_exc_stack
+    ip++; // skip scope_params
+    ip++; // skip n_pos_args
+    ip++; // skip n_kwonly_args
+    ip++; // skip n_def_pos_args
+    mp_decode_uint(&ip); // skip code_info_size
+    #if MICROPY_PERSISTENT_CODE
+    e->name = ip[0] | (ip[1] << 8);
+    e->file = ip[2] | (ip[3] << 8);
+    ip += 4;
+    #else
+    e->name = mp_decode_uint(&ip);
+    e->file = mp_decode_uint(&ip);
+    #endif
+    uint32_t line = 1;
+    size_t c;
+    while ((c = *ip)) {
+        size_t b, l;
+        if ((c & 0x80) == 0) {
+            // 0b0LLBBBBB encoding
+            b = c & 0x1f;
+            l = c >> 5;
+            ip += 1;
+        } else {
+            // 0b1LLLBBBB 0bLLLLLLLL encoding (l's LSB in second byte)
+            b = c & 0xf;
+            l = ((c << 4) & 0x700) | ip[1];
+            ip += 2;
+        }
+        if (b > 0) {
+            break;
+        }
+        line += l;
+    }
+    e->line = line;
+}
+
+void frametrace_enter(const void *frame, const void *code_state)
+{
+    if (!frametrace_enabled()) {
+        return;
+    }
+    const uint32_t t = now_us();
+    const void *fun = ((const mp_code_state_t *)code_state)->fun_bc;
+    pop_below(frame, t);
+    if (STACK_TOP > 0 && STACK[STACK_TOP - 1].frame == frame) {
+        if (STACK[STACK_TOP - 1].fun == fun) {
+            // dispatch restarted after an exception was caught, or the same
+            // function called again from the same depth, both count as one
+            return;
+        }
+        STACK_TOP--;
+        event_add(t)->name = 0;
+    }
+    if (STACK_TOP == DEPTH) {
+        return;
+    }
+    STACK[STACK_TOP].frame = frame;
+    STACK[STACK_TOP].fun = fun;
+    STACK_TOP++;
+    code_state_info(code_state, event_add(t));
+}
+
+void frametrace_loop(const void *frame)
+{
+    if (ENABLED > 0) {
+        pop_below(frame, now_us());
+    }
+}
+
+void frametrace_return(const void *frame)
+{
+    if (ENABLED > 0) {
+        const uint32_t t = now_us();
+        pop_below(frame, t);
+        if (STACK_TOP > 0 && STACK[STACK_TOP - 1].frame == frame) {
+            STACK_TOP--;
+            event_add(t)->name = 0;
+        }
+    }
+}
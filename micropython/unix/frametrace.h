@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) Pavol Rusnak, SatoshiLabs
+ *
+ * Licensed under TREZOR License
+ * see LICENSE file for details
+ */
+
+#ifndef __TREZORUNIX_FRAMETRACE_H__
+#define __TREZORUNIX_FRAMETRACE_H__
+
+// called from the VM hooks in mpconfigport.h, frame is the C stack frame
+// of mp_execute_bytecode and code_state its mp_code_state_t
+
+void frametrace_enter(const void *frame, const void *code_state);
+void frametrace_loop(const void *frame);
+void frametrace_return(const void *frame);
+
+#endif
@@ -106,6 +106,15 @@
 #define MICROPY_STACKLESS           (0)
 #define MICROPY_STACKLESS_STRICT    (0)
 
+// Python frame tracing for flamegraphs (see frametrace.c), relies on
+// mp_execute_bytecode recursing on the C stack, i.e. no stackless mode
+#if TREZOR_FRAMETRACE
+#include "frametrace.h"
+#define MICROPY_VM_HOOK_INIT        frametrace_enter(__builtin_frame_address(0), code_state);
+#define MICROPY_VM_HOOK_LOOP        frametrace_loop(__builtin_frame_address(0));
+#define MICROPY_VM_HOOK_RETURN      frametrace_return(__builtin_frame_address(0));
+#endif
+
 #define MICROPY_PY_OS_STATVFS       (1)
 #define MICROPY_PY_UTIME            (1)
 #define MICROPY_PY_UTIME_MP_HAL     (1)
@@ -136,6 +145,8 @@
 #define MICROPY_PY_TREZORCRYPTO     (1)
 #define MICROPY_PY_TREZORDEBUG      (1)
 #define MICROPY_PY_TREZORMSG        (1)
+#define MICROPY_PY_TREZORRES        (1)
+#define MICROPY_PY_TREZORTELEMETRY  (1)
 #define MICROPY_PY_TREZORUI         (1)
 #define MICROPY_PY_TREZORUTILS      (1)
 
@@ -179,6 +190,8 @@ extern const struct _mp_obj_module_t mp_module_TrezorConfig;
 extern const struct _mp_obj_module_t mp_module_TrezorCrypto;
 extern const struct _mp_obj_module_t mp_module_TrezorDebug;
 extern const struct _mp_obj_module_t mp_module_TrezorMsg;
+extern const struct _mp_obj_module_t mp_module_TrezorRes;
+extern const struct _mp_obj_module_t mp_module_TrezorTelemetry;
 extern const struct _mp_obj_module_t mp_module_TrezorUi;
 extern const struct _mp_obj_module_t mp_module_TrezorUtils;
 
@@ -238,6 +251,16 @@ extern const struct _mp_obj_module_t mp_module_TrezorUtils;
 #else
 #define MICROPY_PY_TREZORMSG_DEF
 #endif
+#if MICROPY_PY_TREZORRES
+#define MICROPY_PY_TREZORRES_DEF { MP_ROM_QSTR(MP_QSTR_TrezorRes), MP_ROM_PTR(&mp_module_TrezorRes) },
+#else
+#define MICROPY_PY_TREZORRES_DEF
+#endif
+#if MICROPY_PY_TREZORTELEMETRY
+#define MICROPY_PY_TREZORTELEMETRY_DEF { MP_ROM_QSTR(MP_QSTR_TrezorTelemetry), MP_ROM_PTR(&mp_module_TrezorTelemetry) },
+#else
+#define MICROPY_PY_TREZORTELEMETRY_DEF
+#endif
 #if MICROPY_PY_TREZORUI
 #define MICROPY_PY_TREZORUI_DEF { MP_ROM_QSTR(MP_QSTR_TrezorUi), MP_ROM_PTR(&mp_module_TrezorUi) },
 #else
@@ -263,6 +286,8 @@ extern const struct _mp_obj_module_t mp_module_TrezorUtils;
     MICROPY_PY_TREZORCRYPTO_DEF \
     MICROPY_PY_TREZORDEBUG_DEF \
     MICROPY_PY_TREZORMSG_DEF \
+    MICROPY_PY_TREZORRES_DEF \
+    MICROPY_PY_TREZORTELEMETRY_DEF \
     MICROPY_PY_TREZORUI_DEF \
     MICROPY_PY_TREZORUTILS_DEF \
 
@@ -12,9 +12,16 @@
 
 #include "options.h"
 
+#ifndef TREZOR_NOUI
+extern int HEADLESS; // defined in extmod/modtrezorui/display-unix.h
+#endif
+
 uint32_t touch_read(void)
 {
 #ifndef TREZOR_NOUI
+    if (HEADLESS) {
+        return 0;
+    }
     SDL_Event event;
     int x, y;
     SDL_PumpEvents();
@@ -10,3 +10,23 @@ def from_seed(seed: bytes, curve_name: str) -> HDNode:
     '''
     Construct a BIP0032 HD node from a BIP0039 seed value.
     '''
+
+# extmod/modtrezorcrypto/modtrezorcrypto-bip32.h
+def cache_seed(seed: bytes) -> None:
+    '''
+    Store a BIP0039 seed in the root node cache, dropping all root nodes
+    cached for the previous seed.
+    '''
+
+# extmod/modtrezorcrypto/modtrezorcrypto-bip32.h
+def cached_root(curve_name: str) -> HDNode:
+    '''
+    Return a copy of the root node for the cached seed and given curve, or
+    None if no seed is cached.  Root nodes are derived once per curve.
+    '''
+
+# extmod/modtrezorcrypto/modtrezorcrypto-bip32.h
+def clear_cache() -> None:
+    '''
+    Wipe the cached seed and all cached root nodes.
+    '''
@@ -0,0 +1,21 @@
+
+# extmod/modtrezormsg/modtrezormsg-demux.h
+def open(self, session_id: int) -> None:
+    '''
+    Starts reassembling messages of the session.
+    '''
+
+# extmod/modtrezormsg/modtrezormsg-demux.h
+def close(self, session_id: int) -> None:
+    '''
+    Stops reassembling messages of the session, drops its buffer.
+    '''
+
+# extmod/modtrezormsg/modtrezormsg-demux.h
+def feed(self, report: bytes) -> tuple:
+    '''
+    Processes a wire v2 report.  Returns None if the report was consumed,
+    otherwise a tuple (event, session_id, msg_type, data_len, offset, chunk),
+    where chunk is a memoryview of message data, valid until the next call,
+    and offset is its position in the message data (zero for the first).
+    '''
@@ -0,0 +1,13 @@
+
+# extmod/modtrezorres/modtrezorres.c
+def hash(name: str) -> int:
+    '''
+    Returns the hash of the resource name, as used by the resource pack.
+    '''
+
+# extmod/modtrezorres/modtrezorres.c
+def get(name_hash: int) -> memoryview:
+    '''
+    Returns a read-only view of the resource stored in the resource pack
+    or None if there is no resource with this name hash.
+    '''
@@ -0,0 +1,71 @@
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def record(histogram: int, us: int) -> None:
+    '''
+    Records duration us (in microseconds) into the histogram.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def task_resumed(task) -> int:
+    '''
+    Marks the start of a task step and returns the current time in microseconds.
+    Records the time the task spent waiting in a syscall (see task_suspended).
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def task_suspended(task, start: int, wait: int) -> None:
+    '''
+    Records the duration of a task step started at start (see task_resumed).
+    If wait is a WAIT_* histogram, time until the task is resumed is recorded into it.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def collect() -> None:
+    '''
+    Runs garbage collection and records its pause.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def snapshot() -> bytes:
+    '''
+    Returns current counters and histograms, see tools/telemetry for the layout.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def reset() -> None:
+    '''
+    Clears all histograms.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def publish() -> None:
+    '''
+    Sends the snapshot as a UDP datagram to TREZOR_TELEMETRY_PORT (emulator only).
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def heap_profile(enable: bool) -> None:
+    '''
+    Starts (clearing previous records) or stops tracking of heap allocations.
+    Does nothing unless the firmware is built with TREZOR_HEAPPROF=1.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def heap_site(name: str) -> None:
+    '''
+    Attributes following heap allocations to the site name.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def heap_info() -> tuple:
+    '''
+    Returns total, free and the largest contiguous free heap size in bytes.
+    '''
+
+# extmod/modtrezortelemetry/modtrezortelemetry.c
+def heap_report() -> bytes:
+    '''
+    Returns a text report of the heap: a "heap <total> <free> <largest free>"
+    line followed by "<site> <size class> <count> <bytes>" lines of live
+    allocations, size class being the allocated size rounded down to a power of 2.
+    '''
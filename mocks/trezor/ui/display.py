@@ -6,9 +6,10 @@ def clear() -> None
     '''
 
 # extmod/modtrezorui/modtrezorui-display.h
-def refresh() -> None
+def refresh() -> bool
     '''
     Refresh display (update screen)
+    Returns True if a new frame was presented.
     '''
 
 # extmod/modtrezorui/modtrezorui-display.h
@@ -78,6 +79,20 @@ def qrcode(x: int, y: int, data: bytes, scale: int) -> None:
     Scale determines a zoom factor.
     '''
 
+# extmod/modtrezorui/modtrezorui-display.h
+def qrcode_prepare(data: bytes) -> bytes:
+    '''
+    Encodes data as a QR code and returns its bitmap for qrcode_bitmap.
+    First byte is the side of the code in modules, the rest are the modules.
+    '''
+
+# extmod/modtrezorui/modtrezorui-display.h
+def qrcode_bitmap(x: int, y: int, bitmap: bytes, scale: int) -> None:
+    '''
+    Renders a QR code bitmap returned by qrcode_prepare centered at position (x,y).
+    Scale determines a zoom factor.
+    '''
+
 # extmod/modtrezorui/modtrezorui-display.h
 def loader(progress: int, yoffset: int, fgcolor: int, bgcolor: int, icon: bytes=None, iconfgcolor: int=None) -> None:
     '''
@@ -85,6 +100,7 @@ def loader(progress: int, yoffset: int, fgcolor: int, bgcolor: int, icon: bytes=
     Progress determines its position (0-1000), fgcolor is used as foreground color, bgcolor as background.
     When icon and iconfgcolor are provided, an icon is drawn in the middle using the color specified in iconfgcolor.
     Icon needs to be of exactly LOADER_ICON_SIZE x LOADER_ICON_SIZE pixels size.
+    When only progress changed since the previous call, just the affected part of the ring is repainted.
     '''
 
 # extmod/modtrezorui/modtrezorui-display.h
@@ -113,4 +129,5 @@ def offset(xy: tuple=None) -> tuple:
 def save(filename: string) -> None:
     '''
     Saves current display contents to file filename.
+    Writes a PNG image, or raw RGB565 pixels when filename ends with .raw.
     '''
@@ -1,4 +1,4 @@
-from trezor import wire, ui, loop
+from trezor import wire, ui, loop, workflow
 from trezor.utils import unimport
 
 # used to confirm/cancel the dialogs from outside of this module (i.e.
@@ -13,6 +13,7 @@ async def confirm(session_id, content=None, code=None, *args, **kwargs):
     from trezor.messages.ButtonRequestType import Other
     from trezor.messages.wire_types import ButtonAck
 
+    await workflow.acquire_ui(session_id)
     ui.display.clear()
     dialog = ConfirmDialog(content, *args, **kwargs)
     dialog.render()
@@ -30,6 +31,7 @@ async def hold_to_confirm(session_id, content=None, code=None, *args, **kwargs):
     from trezor.messages.ButtonRequestType import Other
     from trezor.messages.wire_types import ButtonAck
 
+    await workflow.acquire_ui(session_id)
     ui.display.clear()
 
     dialog = HoldToConfirmDialog(content, 'Hold to confirm', *args, **kwargs)
@@ -1,4 +1,4 @@
-from trezor import ui, wire
+from trezor import ui, wire, workflow
 
 
 async def request_passphrase(session_id):
@@ -7,6 +7,7 @@ async def request_passphrase(session_id):
     from trezor.messages.wire_types import PassphraseAck, Cancel
     from trezor.ui.text import Text
 
+    await workflow.acquire_ui(session_id)
     ui.display.clear()
     text = Text('Enter passphrase', ui.ICON_RESET,
                 'Please enter passphrase', 'on your computer.')
@@ -1,5 +1,6 @@
 from trezor import ui
 from trezor import wire
+from trezor import workflow
 from trezor.utils import unimport
 
 if __debug__:
@@ -20,6 +21,7 @@ async def request_pin_on_display(session_id: int, code: int=None) -> str:
 
     _, label = _get_code_and_label(code)
 
+    await workflow.acquire_ui(session_id)
     await wire.call(session_id,
                     ButtonRequest(code=ProtectCall),
                     ButtonAck)
@@ -47,6 +49,7 @@ async def request_pin_on_client(session_id: int, code: int=None) -> str:
 
     code, label = _get_code_and_label(code)
 
+    await workflow.acquire_ui(session_id)
     ui.display.clear()
     matrix = PinMatrix(label)
     matrix.render()
@@ -1,26 +1,29 @@
+from micropython import const
+
+from trezor import loop
+from trezor import ui
 from trezor import wire
+from trezor import workflow
 from trezor.crypto import bip32
-from trezor.crypto import bip39
+from trezor.crypto import pbkdf2
 
 _DEFAULT_CURVE = 'secp256k1'
 
-_cached_seed = None
+_SEED_ITERATIONS = const(2048)  # PBKDF2 rounds, as in BIP-0039
+_SEED_ITERATIONS_STEP = const(128)  # PBKDF2 rounds per event loop step
 
 
 async def get_root(session_id: int, curve_name=_DEFAULT_CURVE):
-    seed = await get_seed(session_id)
-    root = bip32.from_seed(seed, curve_name)
+    # the seed and root nodes are cached natively, because this module gets
+    # unimported after every workflow.  the cache is wiped in storage.lock()
+    root = bip32.cached_root(curve_name)
+    if root is None:
+        await compute_seed(session_id)
+        root = bip32.cached_root(curve_name)
     return root
 
 
-async def get_seed(session_id: int) -> bytes:
-    global _cached_seed
-    if _cached_seed is None:
-        _cached_seed = await compute_seed(session_id)
-    return _cached_seed
-
-
-async def compute_seed(session_id: int) -> bytes:
+async def compute_seed(session_id: int) -> None:
     from trezor.messages.FailureType import Other
     from .request_passphrase import protect_by_passphrase
     from .request_pin import protect_by_pin
@@ -29,7 +32,27 @@ async def compute_seed(session_id: int) -> bytes:
     if not storage.is_initialized():
         raise wire.FailureError(Other, 'Device is not initialized')
 
+    # pin, passphrase and the loader below use the screen
+    await workflow.acquire_ui(session_id)
+    if bip32.cached_root(_DEFAULT_CURVE) is not None:
+        return  # computed by another session while waiting for the screen
     await protect_by_pin(session_id)
 
     passphrase = await protect_by_passphrase(session_id)
-    return bip39.seed(storage.get_mnemonic(), passphrase)
+    seed = await derive_seed(storage.get_mnemonic(), passphrase)
+    bip32.cache_seed(seed)
+
+
+async def derive_seed(mnemonic: str, passphrase: str) -> bytes:
+    '''
+    Equivalent of bip39.seed(), but runs the key stretching in chunks and
+    yields to the event loop between them, so USB and touch events keep
+    being served.  Progress is rendered as a loader.
+    '''
+    ctx = pbkdf2('hmac-sha512', mnemonic, 'mnemonic' + passphrase)
+    ui.display.clear()
+    for i in range(_SEED_ITERATIONS_STEP, _SEED_ITERATIONS + 1, _SEED_ITERATIONS_STEP):
+        ctx.update(_SEED_ITERATIONS_STEP)
+        ui.display.loader(i * 1000 // _SEED_ITERATIONS, -8, ui.WHITE, ui.BLACK)
+        await loop.Sleep(0)
+    return ctx.key()
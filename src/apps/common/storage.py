@@ -4,6 +4,7 @@ import utime
 
 from trezor import config
 from trezor import utils
+from trezor.crypto import bip32
 
 _APP = const(1)
 
@@ -58,6 +59,7 @@ def unlock(user_pin: str, failure_callback=None) -> bool:
 def lock():
     global _locked
     _locked = True
+    bip32.clear_cache()
 
 
 def const_equal(a: bytes, b: bytes) -> bool:
@@ -141,6 +143,7 @@ def load_settings(language: str=None,
     if passphrase_protection is not None:
         config_set(PASSPHRASE_PROTECTION,
                    int_to_bytes(passphrase_protection))
+        bip32.clear_cache()  # cached seed depends on the passphrase
 
 
 def wipe():
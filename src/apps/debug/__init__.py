@@ -42,11 +42,17 @@ async def dispatch_DebugLinkStop(session_id, msg):
 
 async def dispatch_DebugLinkMemoryRead(session_id, msg):
     from trezor.messages.DebugLinkMemory import DebugLinkMemory
-    from trezor.debug import memaccess
+    from trezor.debug import memaccess, MEM_TELEMETRY, MEM_HEAP
+    from trezor import telemetry
 
     length = min(msg.length, 1024)
     m = DebugLinkMemory()
-    m.memory = memaccess(msg.address, length)
+    if msg.address == MEM_TELEMETRY:
+        m.memory = telemetry.snapshot()
+    elif msg.address == MEM_HEAP:
+        m.memory = telemetry.heap_report()
+    else:
+        m.memory = memaccess(msg.address, length)
 
     return m
 
@@ -62,9 +68,9 @@ async def dispatch_DebugLinkFlashErase(session_id, msg):
 
 
 def boot():
-    register(DebugLinkDecision, protobuf_workflow, dispatch_DebugLinkDecision)
-    register(DebugLinkGetState, protobuf_workflow, dispatch_DebugLinkGetState)
-    register(DebugLinkStop, protobuf_workflow, dispatch_DebugLinkStop)
-    register(DebugLinkMemoryRead, protobuf_workflow, dispatch_DebugLinkMemoryRead)
-    register(DebugLinkMemoryWrite, protobuf_workflow, dispatch_DebugLinkMemoryWrite)
-    register(DebugLinkFlashErase, protobuf_workflow, dispatch_DebugLinkFlashErase)
+    register(DebugLinkDecision, protobuf_workflow, dispatch_DebugLinkDecision, ui=False)
+    register(DebugLinkGetState, protobuf_workflow, dispatch_DebugLinkGetState, ui=False)
+    register(DebugLinkStop, protobuf_workflow, dispatch_DebugLinkStop, ui=False)
+    register(DebugLinkMemoryRead, protobuf_workflow, dispatch_DebugLinkMemoryRead, ui=False)
+    register(DebugLinkMemoryWrite, protobuf_workflow, dispatch_DebugLinkMemoryWrite, ui=False)
+    register(DebugLinkFlashErase, protobuf_workflow, dispatch_DebugLinkFlashErase, ui=False)
@@ -10,4 +10,4 @@ def dispatch_EthereumGetAddress(*args, **kwargs):
     return layout_ethereum_get_address(*args, **kwargs)
 
 def boot():
-    register(EthereumGetAddress, protobuf_workflow, dispatch_EthereumGetAddress)
+    register(EthereumGetAddress, protobuf_workflow, dispatch_EthereumGetAddress, ui=False)
@@ -24,12 +24,15 @@ async def layout_ethereum_get_address(session_id, msg):
 async def _show_address(session_id, address):
     from trezor.messages.ButtonRequestType import Address
     from trezor.ui.text import Text
+    from trezor.ui.qr import Qr
+    from trezor.ui.container import Container
+    from ubinascii import hexlify
     from ..common.confirm import require_confirm
 
-    # TODO: qr code
-
-    content = Text('Confirm address', ui.ICON_RESET,
-                   ui.MONO, *_split_address(address))
+    content = Container(
+        Qr('0x' + hexlify(address).decode('ascii'), (120, 135), 3),
+        Text('Confirm address', ui.ICON_RESET,
+             ui.MONO, *_split_address(address)))
     await require_confirm(session_id, content, code=Address)
 
 
@@ -48,6 +48,6 @@ async def respond_Pong(session_id, msg):
 
 
 def boot():
-    register(Initialize, protobuf_workflow, respond_Features)
-    register(GetFeatures, protobuf_workflow, respond_Features)
-    register(Ping, protobuf_workflow, respond_Pong)
+    register(Initialize, protobuf_workflow, respond_Features, ui=False)
+    register(GetFeatures, protobuf_workflow, respond_Features, ui=False)
+    register(Ping, protobuf_workflow, respond_Pong, ui=False)
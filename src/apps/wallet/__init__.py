@@ -59,10 +59,10 @@ def dispatch_CipherKeyValue(*args, **kwargs):
 
 
 def boot():
-    register(GetPublicKey, protobuf_workflow, dispatch_GetPublicKey)
-    register(GetAddress, protobuf_workflow, dispatch_GetAddress)
+    register(GetPublicKey, protobuf_workflow, dispatch_GetPublicKey, ui=False)
+    register(GetAddress, protobuf_workflow, dispatch_GetAddress, ui=False)
     register(SignTx, protobuf_workflow, dispatch_SignTx)
-    register(EstimateTxSize, protobuf_workflow, dispatch_EstimateTxSize)
+    register(EstimateTxSize, protobuf_workflow, dispatch_EstimateTxSize, ui=False)
     register(SignMessage, protobuf_workflow, dispatch_SignMessage)
     register(VerifyMessage, protobuf_workflow, dispatch_VerifyMessage)
     register(SignIdentity, protobuf_workflow, dispatch_SignIdentity)
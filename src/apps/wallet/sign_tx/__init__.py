@@ -1,11 +1,13 @@
 from trezor.utils import unimport
 from trezor import wire
+import protobuf
 
 
 @unimport
 async def sign_tx(session_id, msg):
     from trezor.messages.RequestType import TXFINISHED
     from trezor.messages.wire_types import TxAck
+    from trezor.messages.TxAck import TxAck as TxAckType
 
     from apps.common import seed
     from . import signing
@@ -13,6 +15,8 @@ async def sign_tx(session_id, msg):
 
     root = await seed.get_root(session_id)
 
+    # acks are decoded in place, the signer does not hold onto them
+    ack = protobuf.MessagePool(TxAckType)
     signer = signing.sign_tx(msg, root)
     res = None
     while True:
@@ -23,7 +27,7 @@ async def sign_tx(session_id, msg):
         if req.__qualname__ == 'TxRequest':
             if req.request_type == TXFINISHED:
                 break
-            res = await wire.call(session_id, req, TxAck)
+            res = await wire.call(session_id, req, TxAck, pool=ack)
         elif req.__qualname__ == 'UiConfirmOutput':
             res = await layout.confirm_output(session_id, req.output, req.coin)
         elif req.__qualname__ == 'UiConfirmTotal':
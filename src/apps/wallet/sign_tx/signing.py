@@ -3,6 +3,8 @@ from trezor.crypto.curve import secp256k1
 from trezor.crypto import base58, der
 from trezor.utils import ensure
 
+from protobuf import copy_message
+
 from trezor.messages.CoinType import CoinType
 from trezor.messages.SignTx import SignTx
 from trezor.messages.TxOutputType import TxOutputType
@@ -161,6 +163,11 @@ async def sign_tx(tx: SignTx, root):
     tx_req = TxRequest()
     tx_req.details = TxRequestDetailsType()
 
+    # output scripts are rebuilt for every output in every phase and consumed
+    # right away, the fixed-size ones are written over these buffers
+    p2pkh_buf = bytearray(25)
+    p2sh_buf = bytearray(23)
+
     for i in range(tx.inputs_count):
         # STAGE_REQUEST_1_INPUT
         txi = await request_tx_input(tx_req, i)
@@ -181,7 +188,8 @@ async def sign_tx(tx: SignTx, root):
                 raise SigningError(FailureType.ActionCancelled,
                                    'Output cancelled')
         txo_bin.amount = txo.amount
-        txo_bin.script_pubkey = output_derive_script(txo, coin, root)
+        txo_bin.script_pubkey = output_derive_script(
+            txo, coin, root, p2pkh_buf, p2sh_buf)
         write_tx_output(h_first, txo_bin)
         total_out += txo_bin.amount
 
@@ -225,7 +233,9 @@ async def sign_tx(tx: SignTx, root):
             txi = await request_tx_input(tx_req, i)
             write_tx_input_check(h_second, txi)
             if i == i_sign:
-                txi_sign = txi
+                # the acks are decoded in place, keep a deep copy past the
+                # next one (address_n and multisig are reused by the pool)
+                txi_sign = copy_message(txi)
                 key_sign = node_derive(root, txi.address_n)
                 key_sign_pub = key_sign.public_key()
                 txi.script_sig = input_derive_script(txi, key_sign_pub)
@@ -239,7 +249,8 @@ async def sign_tx(tx: SignTx, root):
             # STAGE_REQUEST_4_OUTPUT
             txo = await request_tx_output(tx_req, o)
             txo_bin.amount = txo.amount
-            txo_bin.script_pubkey = output_derive_script(txo, coin, root)
+            txo_bin.script_pubkey = output_derive_script(
+                txo, coin, root, p2pkh_buf, p2sh_buf)
             write_tx_output(h_second, txo_bin)
             write_tx_output(h_sign, txo_bin)
 
@@ -274,7 +285,8 @@ async def sign_tx(tx: SignTx, root):
         # STAGE_REQUEST_5_OUTPUT
         txo = await request_tx_output(tx_req, o)
         txo_bin.amount = txo.amount
-        txo_bin.script_pubkey = output_derive_script(txo, coin, root)
+        txo_bin.script_pubkey = output_derive_script(
+            txo, coin, root, p2pkh_buf, p2sh_buf)
 
         # serialize output
         w_txo_bin = bytearray_with_cap(
@@ -298,27 +310,31 @@ async def get_prevtx_output_value(tx_req: TxRequest, prev_hash: bytes, prev_inde
 
     # STAGE_REQUEST_2_PREV_META
     tx = await request_tx_meta(tx_req, prev_hash)
+    # the acks are decoded in place, tx is overwritten by the next request
+    inputs_cnt = tx.inputs_cnt
+    outputs_cnt = tx.outputs_cnt
+    lock_time = tx.lock_time
 
     txh = HashWriter(sha256)
 
     write_uint32(txh, tx.version)
-    write_varint(txh, tx.inputs_cnt)
+    write_varint(txh, inputs_cnt)
 
-    for i in range(tx.inputs_cnt):
+    for i in range(inputs_cnt):
         # STAGE_REQUEST_2_PREV_INPUT
         txi = await request_tx_input(tx_req, i, prev_hash)
         write_tx_input(txh, txi)
 
-    write_varint(txh, tx.outputs_cnt)
+    write_varint(txh, outputs_cnt)
 
-    for o in range(tx.outputs_cnt):
+    for o in range(outputs_cnt):
         # STAGE_REQUEST_2_PREV_OUTPUT
         txo_bin = await request_tx_output(tx_req, o, prev_hash)
         write_tx_output(txh, txo_bin)
         if o == prev_index:
             total_out += txo_bin.amount
 
-    write_uint32(txh, tx.lock_time)
+    write_uint32(txh, lock_time)
 
     if get_tx_hash(txh, True, True) != prev_hash:
         raise SigningError(FailureType.Other,
@@ -344,16 +360,17 @@ def estimate_tx_size(inputs, outputs):
 # ===
 
 
-def output_derive_script(o: TxOutputType, coin: CoinType, root) -> bytes:
+def output_derive_script(o: TxOutputType, coin: CoinType, root,
+                         p2pkh_buf=None, p2sh_buf=None) -> bytes:
     if o.script_type == OutputScriptType.PAYTOADDRESS:
         ra = output_paytoaddress_extract_raw_address(o, coin, root)
         ra = address_type.strip(coin.address_type, ra)
-        return script_paytoaddress_new(ra)
+        return script_paytoaddress_new(ra, p2pkh_buf)
 
     elif o.script_type == OutputScriptType.PAYTOSCRIPTHASH:
         ra = output_paytoaddress_extract_raw_address(o, coin, root, p2sh=True)
         ra = address_type.strip(coin.address_type_p2sh, ra)
-        return script_paytoscripthash_new(ra)
+        return script_paytoscripthash_new(ra, p2sh_buf)
 
     elif o.script_type == OutputScriptType.PAYTOOPRETURN:
         if o.amount == 0:
@@ -433,8 +450,9 @@ def ecdsa_sign(node, digest: bytes) -> bytes:
 # ===
 
 
-def script_paytoaddress_new(pubkeyhash: bytes) -> bytearray:
-    s = bytearray(25)
+def script_paytoaddress_new(pubkeyhash: bytes, s=None) -> bytearray:
+    if s is None:
+        s = bytearray(25)
     s[0] = 0x76  # OP_DUP
     s[1] = 0xA9  # OP_HASH_160
     s[2] = 0x14  # pushing 20 bytes
@@ -444,8 +462,9 @@ def script_paytoaddress_new(pubkeyhash: bytes) -> bytearray:
     return s
 
 
-def script_paytoscripthash_new(scripthash: bytes) -> bytearray:
-    s = bytearray(23)
+def script_paytoscripthash_new(scripthash: bytes, s=None) -> bytearray:
+    if s is None:
+        s = bytearray(23)
     s[0] = 0xA9  # OP_HASH_160
     s[1] = 0x14  # pushing 20 bytes
     s[2:22] = scripthash
@@ -17,7 +17,7 @@ synchronously with `loads()` and `dumps()`.
 '''
 
 from micropython import const
-from streams import StreamReader, BufferWriter
+from streams import StreamReader, BufferWriter, CountingWriter
 
 
 def build_message(msg_type, callback=None, *args):
@@ -40,6 +40,68 @@ def build_message(msg_type, callback=None, *args):
         return msg
 
 
+class MessagePool:
+    '''
+    Caller-owned message of `msg_type`, decoded in place by
+    `build_message_into`.  Nested messages and lists of the previous decode
+    are kept aside and reused by the next one, so decoding the same message
+    type over and over again does not grow the heap.  Values of a decode are
+    overwritten by the next one, callers must not hold onto them.
+    '''
+
+    def __init__(self, msg_type):
+        self.msg_type = msg_type
+        self.msg = msg_type()
+        self.spares = {}  # id(message) -> {field name: message or [list, elements]}
+
+
+def build_message_into(pool, callback=None, *args):
+    msg = yield from _build_message_into(pool, pool.msg)
+    if callback is not None:
+        callback(msg, *args)
+    return msg
+
+
+def _build_message_into(pool, msg):
+    spares = pool.spares.get(id(msg))
+    if spares is None:
+        spares = pool.spares[id(msg)] = {}
+    for tag in msg.FIELDS:
+        setattr(msg, msg.FIELDS[tag][0], None)
+    counts = None
+    try:
+        while True:
+            field, fvalue = yield
+            fname, ftype, fflags = field
+            if fflags & FLAG_REPEATED:
+                spare = spares.get(fname)
+                if spare is None:
+                    spare = spares[fname] = [[], []]
+                values, elements = spare
+                if counts is None:
+                    counts = {}
+                n = counts.get(fname, 0)
+                if n == 0:
+                    del values[:]
+                    setattr(msg, fname, values)
+                if issubclass(ftype, MessageType):
+                    if n == len(elements):
+                        elements.append(ftype())
+                    fvalue = yield from _build_message_into(pool, elements[n])
+                values.append(fvalue)
+                counts[fname] = n + 1
+            elif issubclass(ftype, MessageType):
+                sub = spares.get(fname)
+                if sub is None:
+                    sub = spares[fname] = ftype()
+                fvalue = yield from _build_message_into(pool, sub)
+                setattr(msg, fname, fvalue)
+            else:
+                setattr(msg, fname, fvalue)
+    except EOFError:
+        return msg
+
+
 def fill_missing_fields(msg):
     for tag in msg.FIELDS:
         field = msg.FIELDS[tag]
@@ -47,6 +109,23 @@ def fill_missing_fields(msg):
             setattr(msg, field[0], None)
 
 
+def copy_message(msg):
+    '''
+    Copy of `msg` not sharing any lists or nested messages with it, safe to
+    keep past the next `build_message_into` of its pool.  Scalar values are
+    shared, decoded bytes and strings are never written to again.
+    '''
+    copy = msg.__class__()
+    for fname, fvalue in msg.__dict__.items():
+        if isinstance(fvalue, list):
+            fvalue = [copy_message(v) if isinstance(v, MessageType) else v
+                      for v in fvalue]
+        elif isinstance(fvalue, MessageType):
+            fvalue = copy_message(fvalue)
+        setattr(copy, fname, fvalue)
+    return copy
+
+
 class Type:
 
     @classmethod
@@ -60,14 +139,21 @@ class Type:
             return e.value
 
     @classmethod
-    def dumps(cls, value):
-        target = BufferWriter()
+    def dumps(cls, value, target=None):
+        '''
+        Serializes `value` into a new bytearray, or into `target` (see
+        `streams.ReusableWriter`) if given, returning a view of its contents.
+        '''
+        if target is None:
+            target = BufferWriter()
+        else:
+            target.reset()
         dumper = cls.dump(value, target)
         try:
             while True:
                 dumper.send(None)
         except StopIteration:
-            return target.buffer
+            return target.getvalue()
 
 
 _uvarint_buffer = bytearray(1)
@@ -208,12 +294,21 @@ class MessageType(Type):
                 for svalue in fvalue:
                     await UVarintType.dump(key, target)
                     if issubclass(ftype, MessageType):
-                        await BytesType.dump(ftype.dumps(svalue), target)
+                        await ftype.dump_embedded(svalue, target)
                     else:
                         await ftype.dump(svalue, target)
             else:
                 await UVarintType.dump(key, target)
                 if issubclass(ftype, MessageType):
-                    await BytesType.dump(ftype.dumps(fvalue), target)
+                    await ftype.dump_embedded(fvalue, target)
                 else:
                     await ftype.dump(fvalue, target)
+
+    @classmethod
+    async def dump_embedded(cls, msg, target):
+        # length-prefixed, the length is measured by a dry run instead of
+        # serializing into a temporary buffer
+        counter = CountingWriter()
+        await cls.dump(msg, counter)
+        await UVarintType.dump(counter.size, target)
+        await cls.dump(msg, target)
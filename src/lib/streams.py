@@ -63,3 +63,42 @@ class BufferWriter:
 
     async def write(self, b):
         self.buffer.extend(b)
+
+    def getvalue(self):
+        return self.buffer
+
+
+class ReusableWriter:
+    '''
+    Writes into a preallocated buffer, which is replaced by a larger one only
+    when it runs out of space, and is kept for the following writes.
+    '''
+
+    def __init__(self, size):
+        self.buffer = bytearray(size)
+        self.ofs = 0
+
+    def reset(self):
+        self.ofs = 0
+
+    async def write(self, b):
+        n = len(b)
+        end = self.ofs + n
+        if end > len(self.buffer):
+            buffer = bytearray(max(end, 2 * len(self.buffer)))
+            memcpy(buffer, 0, self.buffer, 0, self.ofs)
+            self.buffer = buffer
+        memcpy(self.buffer, self.ofs, b, 0, n)
+        self.ofs = end
+
+    def getvalue(self):
+        return memoryview(self.buffer)[:self.ofs]
+
+
+class CountingWriter:
+
+    def __init__(self):
+        self.size = 0
+
+    async def write(self, b):
+        self.size += len(b)
@@ -24,6 +24,10 @@ fido_u2f.boot()
 # HACK: keep storage loaded at all times
 from apps.common import storage
 
+# Keep the modules of recently used workflows loaded while the heap allows
+from trezor import utils
+utils.warm_start(4, 32 * 1024)
+
 # Change backlight to white for better visibility
 ui.display.backlight(ui.BACKLIGHT_NORMAL)
 
@@ -16,6 +16,8 @@ MEM_CCM_END = const(MEM_CCM_BASE + MEM_CCM_SIZE - 1)
 MEM_SRAM_BASE = const(0x20000000)
 MEM_SRAM_SIZE = const(128 * 1024)
 MEM_SRAM_END = const(MEM_SRAM_BASE + MEM_SRAM_SIZE - 1)
+MEM_TELEMETRY = const(0xFFFFFF00)  # reads return trezor.telemetry.snapshot()
+MEM_HEAP = const(0xFFFFFE00)  # reads return trezor.telemetry.heap_report()
 
 def memaccess(address, length):
     return _debug.memaccess(address, length)
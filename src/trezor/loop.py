@@ -13,6 +13,7 @@ import utimeq
 from micropython import const
 from trezor import msg
 from trezor import log
+from trezor import telemetry
 
 # message interfaces:
 # 0x0000           - touch event interface
@@ -31,12 +32,9 @@ _MAX_QUEUE_SIZE = const(64)  # maximum number of scheduled tasks
 _paused_tasks = {}  # {message interface: [task]}
 _scheduled_tasks = utimeq.utimeq(_MAX_QUEUE_SIZE)
 
-if __debug__:
-    # for performance stats
-    import array
-    log_delay_pos = 0
-    log_delay_rb_len = const(10)
-    log_delay_rb = array.array('i', [0] * log_delay_rb_len)
+_profile = None  # {coroutine name: [steps, total us, max us]} when profiling
+_profile_names = {}  # {task: coroutine name}
+_profile_heap = False  # attribute heap allocations to coroutines
 
 
 def schedule_task(task, value=None, deadline=None):
@@ -84,9 +82,6 @@ def run_forever():
     a `Syscall`.
     '''
 
-    if __debug__:
-        global log_delay_pos
-
     task_entry = [0, 0, 0]  # deadline, task, value
     while True:
         # compute the maximum amount of time we can wait for a message
@@ -96,11 +91,6 @@ def run_forever():
         else:
             delay = _MAX_SELECT_DELAY
 
-        if __debug__:
-            # add current delay to ring buffer for performance stats
-            log_delay_rb[log_delay_pos] = delay
-            log_delay_pos = (log_delay_pos + 1) % log_delay_rb_len
-
         msg_entry = msg.select(delay)
         if msg_entry:
             # message received, run tasks paused on the interface
@@ -116,24 +106,131 @@ def run_forever():
 
 
 def _step_task(task, value):
+    start = telemetry.task_resumed(task)
+    wait = -1  # telemetry histogram of the syscall the task is suspended in
+    if _profile is not None:
+        profile_name = _task_name(task)
+        if _profile_heap:
+            telemetry.heap_site(profile_name)
+        profile_start = utime.ticks_us()
     try:
         if isinstance(value, Exception):
             result = task.throw(value)
         else:
             result = task.send(value)
     except StopIteration as e:
+        if _profile is not None:
+            _profile_step(profile_name, profile_start)
+            _profile_names.pop(task, None)
         log.debug(__name__, '%s finished', task)
     except Exception as e:
+        if _profile is not None:
+            _profile_step(profile_name, profile_start)
+            _profile_names.pop(task, None)
         log.exception(__name__, e)
     else:
+        if _profile is not None:
+            _profile_step(profile_name, profile_start)
         if isinstance(result, Syscall):
             result.handle(task)
+            wait = result.wait
         elif result is None:
             schedule_task(task)
         else:
             log.error(__name__, '%s is unknown syscall', result)
-        if after_step_hook:
-            after_step_hook()
+    finally:
+        # the last step of a task is recorded as well, with no wait
+        telemetry.task_suspended(task, start, wait)
+    if after_step_hook:
+        after_step_hook()
+
+
+def start_profiling(heap=False):
+    '''
+    Start recording the number of steps, total and maximum step duration of
+    every coroutine run by the loop.  Clears the previously recorded profile.
+    With `heap`, heap allocations are attributed to the coroutines as well,
+    see `trezor.telemetry.heap_report`.
+    '''
+    global _profile, _profile_heap
+    _profile = {}
+    _profile_names.clear()
+    _profile_heap = heap
+    telemetry.heap_profile(heap)
+
+
+def stop_profiling():
+    '''
+    Stop recording the profile, see `start_profiling`.
+    '''
+    global _profile, _profile_heap
+    _profile = None
+    _profile_names.clear()
+    if _profile_heap:
+        _profile_heap = False
+        telemetry.heap_profile(False)
+
+
+def profile():
+    '''
+    Return the recorded profile as a list of `(name, steps, total_us, max_us)`
+    tuples, sorted by the total time spent stepping the coroutine, the most
+    expensive first.  Coroutines are identified by the name of their function,
+    so all instances of the same workflow are summed up together.
+
+    Example:
+        loop.start_profiling()
+        ...
+        for name, steps, total, worst in loop.profile():
+            print('%s: %d steps, %d us, max %d us' % (name, steps, total, worst))
+    '''
+    if not _profile:
+        return []
+    table = [(name, s[0], s[1], s[2]) for name, s in _profile.items()]
+    table.sort(key=lambda row: row[2], reverse=True)
+    return table
+
+
+def profile_as(task, coro):
+    '''
+    Attribute the steps of `task` to `coro` in the profile.  Used by wrapping
+    coroutines that just await another one, such as `Wait` children.
+    '''
+    if _profile is not None:
+        _profile_names[task] = _coro_name(coro)
+
+
+def _coro_name(coro):
+    if type(coro).__name__ != 'generator':
+        return type(coro).__name__
+    # generator objects have no __name__ attribute, their repr is
+    # "<generator object 'name' at 0x...>"
+    r = repr(coro)
+    i = r.find("'")
+    if i < 0:
+        return r
+    return r[i + 1:r.find("'", i + 1)]
+
+
+def _task_name(task):
+    name = _profile_names.get(task, None)
+    if name is None:
+        if len(_profile_names) >= _MAX_QUEUE_SIZE * 2:
+            # drop names of tasks that were closed without finishing
+            _profile_names.clear()
+        name = _profile_names[task] = _coro_name(task)
+    return name
+
+
+def _profile_step(name, start):
+    us = utime.ticks_diff(utime.ticks_us(), start)
+    stats = _profile.get(name, None)
+    if stats is None:
+        stats = _profile[name] = [0, 0, 0]
+    stats[0] += 1
+    stats[1] += us
+    if us > stats[2]:
+        stats[2] = us
 
 
 class Syscall:
@@ -142,6 +239,8 @@ class Syscall:
     scheduler, they do so through instances of a class derived from `Syscall`.
     '''
 
+    wait = -1  # telemetry histogram for time spent waiting in the syscall
+
     def __iter__(self):
         # support `yield from` or `await` on syscalls
         return (yield self)
@@ -158,6 +257,8 @@ class Sleep(Syscall):
         print('missed by %d us', utime.ticks_diff(utime.ticks_us(), planned))
     '''
 
+    wait = telemetry.WAIT_SLEEP
+
     def __init__(self, delay_us):
         self.delay_us = delay_us
 
@@ -177,6 +278,8 @@ class Select(Syscall):
         event, x, y = await loop.Select(loop.TOUCH)  # await touch event
     '''
 
+    wait = telemetry.WAIT_SELECT
+
     def __init__(self, msg_iface):
         self.msg_iface = msg_iface
 
@@ -202,6 +305,8 @@ class Signal(Syscall):
         # prints in the next iteration of the event loop
     '''
 
+    wait = telemetry.WAIT_SIGNAL
+
     def __init__(self):
         self.value = _NO_VALUE
         self.task = None
@@ -245,6 +350,8 @@ class Wait(Syscall):
     `Wait.__iter__` for explanation.  Always use `await`.
     '''
 
+    wait = telemetry.WAIT_WAIT
+
     def __init__(self, children, wait_for=1, exit_others=True):
         self.children = children
         self.wait_for = wait_for
@@ -257,7 +364,8 @@ class Wait(Syscall):
         self.callback = task
         self.finished = []
         self.scheduled = [self._wait(c) for c in self.children]
-        for ct in self.scheduled:
+        for ct, c in zip(self.scheduled, self.children):
+            profile_as(ct, c)
             schedule_task(ct)
 
     def exit(self):
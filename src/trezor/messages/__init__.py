@@ -1,13 +1,34 @@
+import sys
+
 from . import wire_types
 
+_names = None  # wire type -> message name, indexed on first lookup
+_modules = {}  # wire type -> message module, kept across unimport
+
 
 def get_protobuf_type_name(wire_type):
-    for name in dir(wire_types):
-        if getattr(wire_types, name) == wire_type:
-            return name
+    global _names
+    if _names is None:
+        _names = {}
+        for name in dir(wire_types):
+            value = getattr(wire_types, name)
+            if isinstance(value, int):
+                _names[value] = name
+    return _names.get(wire_type)
 
 
 def get_protobuf_type(wire_type):
     name = get_protobuf_type_name(wire_type)
-    module = __import__('trezor.messages.%s' % name, None, None, (name,) , 0)
+    module = _modules.get(wire_type)
+    if module is None:
+        module = __import__('trezor.messages.%s' % name, None, None, (name,), 0)
+        _modules[wire_type] = module
+    else:
+        # unimport drops the module after a workflow, put it back so that the
+        # workflows importing the message get the same class
+        loaded = sys.modules.get(module.__name__)
+        if loaded is None:
+            sys.modules[module.__name__] = module
+        elif loaded is not module:
+            module = _modules[wire_type] = loaded
     return getattr(module, name)
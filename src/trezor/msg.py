@@ -1,4 +1,4 @@
-from TrezorMsg import Msg, USB, HID, VCP
+from TrezorMsg import Msg, USB, HID, VCP, Demux
 
 _msg = Msg()
 
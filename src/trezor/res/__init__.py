@@ -1,14 +1,14 @@
-try:
-    from .resources import resdata
-except ImportError:
-    resdata = None
+from TrezorRes import get, hash
+
 
 def load(name):
     '''
-    Loads resource of a given name as bytes.
+    Loads resource of a given name as bytes (or a memoryview of the resource
+    pack linked into the firmware).
     '''
-    if resdata and name in resdata:
-        return resdata[name]
+    data = get(hash(name))
+    if data is not None:
+        return data
     with open(name, 'rb') as f:
         return f.read()
 
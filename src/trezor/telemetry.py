@@ -0,0 +1,4 @@
+from TrezorTelemetry import \
+    record, task_resumed, task_suspended, collect, snapshot, reset, publish, \
+    heap_profile, heap_site, heap_info, heap_report, \
+    STEP, GC, WAIT_SLEEP, WAIT_SELECT, WAIT_SIGNAL, WAIT_WAIT
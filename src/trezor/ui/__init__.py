@@ -8,7 +8,52 @@ from trezor import loop, res
 display = Display()
 
 if sys.platform not in ('trezor', 'pyboard'):  # stmhal
-    loop.after_step_hook = display.refresh
+    # the emulator presents the screen at most once per frame interval,
+    # steps drawing in between are coalesced into the next frame
+    _FRAME_US = const(16667)  # 60 fps
+
+    frames = 0  # number of frames presented
+    dropped = 0  # number of frame intervals missed by late refreshes
+    _last_frame = utime.ticks_us()
+    _deadline = _last_frame
+    _pending = False
+    _refreshed = False
+
+    class _Park(loop.Syscall):
+
+        def handle(self, task):
+            pass  # the refresh task is rescheduled by _after_step
+
+    def _refresh_task():
+        global frames, dropped, _last_frame, _pending, _refreshed
+        park = _Park()
+        while True:
+            now = utime.ticks_us()
+            if display.refresh():  # False if nothing has been drawn
+                frames += 1
+                late = utime.ticks_diff(now, _deadline)
+                if late > _FRAME_US:
+                    dropped += late // _FRAME_US
+                _last_frame = now
+            _pending = False
+            _refreshed = True
+            yield park
+
+    _refresher = _refresh_task()
+
+    def _after_step():
+        global _deadline, _pending, _refreshed
+        if _refreshed:
+            _refreshed = False  # step of the refresh task itself
+        elif not _pending:
+            _pending = True
+            now = utime.ticks_us()
+            _deadline = utime.ticks_add(_last_frame, _FRAME_US)
+            if utime.ticks_diff(_deadline, now) < 0:
+                _deadline = now
+            loop.schedule_task(_refresher, None, _deadline)
+
+    loop.after_step_hook = _after_step
 
 
 def rgbcolor(r: int, g: int, b: int) -> int:
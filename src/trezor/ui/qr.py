@@ -7,9 +7,10 @@ class Qr:
         self.data = data
         self.pos = pos
         self.scale = scale
+        self.bitmap = ui.display.qrcode_prepare(data)
 
     def render(self):
-        ui.display.qrcode(self.pos[0], self.pos[1], self.data, self.scale)
+        ui.display.qrcode_bitmap(self.pos[0], self.pos[1], self.bitmap, self.scale)
 
     def send(self, event, pos):
         pass
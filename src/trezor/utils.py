@@ -1,40 +1,141 @@
 import sys
-import gc
 
 from TrezorUtils import halt, memcpy
 from trezor import log
+from trezor import telemetry
 
 type_gen = type((lambda: (yield))())
 type_genfunc = type((lambda: (yield)))
 
 
+_warm = []  # unimported functions keeping their modules, least recent first
+_warm_modules = {}  # function -> names of the modules it imported
+_warm_count = 0
+_warm_min_free = 0
+_warm_stats = [0, 0, 0]  # hits, misses, evictions
+
+
+def warm_start(count, min_free=0):
+    '''
+    Keeps the modules imported by up to `count` most recently called
+    `unimport` functions loaded, so that calling them again does not load the
+    modules again.  The least recently used are unimported while less than
+    `min_free` bytes of heap are free.  Zero `count` unimports after every
+    call.
+    '''
+    global _warm_count, _warm_min_free
+    _warm_count = count
+    _warm_min_free = min_free
+    while len(_warm) > count:
+        _warm_evict()
+    telemetry.collect()
+
+
+def warm_stats():
+    '''
+    Returns hits, misses and evictions of the warm modules, and the number of
+    functions currently keeping their modules loaded.
+    '''
+    return _warm_stats[0], _warm_stats[1], _warm_stats[2], len(_warm)
+
+
+def _warm_evict():
+    func = _warm.pop(0)
+    _unimport(_warm_modules.pop(func))
+    _warm_stats[2] += 1
+
+
+# workflows run concurrently, so every module is owned by the unimport
+# function that was running when it got imported, and only that one
+# unimports it.  nested unimport functions own what they import themselves
+_unimport_known = set()  # modules owned or loaded outside of unimport
+_unimport_current = None  # modules owned by the running unimport function
+
+
+def _unimport(mods):
+    for mod in mods:
+        if mod in sys.modules:
+            log.debug(__name__, 'unimport %s', mod)
+            del sys.modules[mod]
+        _unimport_known.discard(mod)
+
+
+def _unimport_claim():
+    # modules imported since the last claim go to the running function
+    global _unimport_known
+    if len(sys.modules) != len(_unimport_known):
+        mods = set(sys.modules)
+        if _unimport_current is not None:
+            _unimport_current.extend(
+                [mod for mod in mods if mod not in _unimport_known])
+        _unimport_known = mods
+
+
+def _unimport_end(func, mods):
+    if _warm_count > 0:
+        if func in _warm_modules:
+            _warm.remove(func)
+            _warm_modules[func].extend(mods)
+            _warm_stats[0] += 1
+        else:
+            _warm_modules[func] = mods
+            _warm_stats[1] += 1
+        _warm.append(func)
+        while len(_warm) > _warm_count:
+            _warm_evict()
+    else:
+        _unimport(mods)
+    telemetry.collect()
+    while _warm and _warm_min_free and telemetry.heap_info()[1] < _warm_min_free:
+        _warm_evict()
+        telemetry.collect()
+
+
 def _unimport_func(func):
     def inner(*args, **kwargs):
-        mods = set(sys.modules)
+        global _unimport_current
+        _unimport_claim()
+        outer = _unimport_current
+        mods = _unimport_current = []
         try:
-            ret = func(*args, **kwargs)
+            return func(*args, **kwargs)
         finally:
-            for mod in sys.modules:
-                if mod not in mods:
-                    log.debug(__name__, 'unimport %s', mod)
-                    del sys.modules[mod]
-            gc.collect()
-        return ret
+            _unimport_claim()
+            _unimport_current = outer
+            _unimport_end(func, mods)
     return inner
 
 
 def _unimport_genfunc(genfunc):
-    async def inner(*args, **kwargs):
-        mods = set(sys.modules)
+    # steps through the workflow itself, to tell what each step imports
+    def inner(*args, **kwargs):
+        global _unimport_current
+        gen = genfunc(*args, **kwargs)
+        mods = []
+        value = None
+        exc = None
         try:
-            ret = await genfunc(*args, **kwargs)
+            while True:
+                _unimport_claim()
+                outer = _unimport_current
+                _unimport_current = mods
+                try:
+                    if exc is None:
+                        value = gen.send(value)
+                    else:
+                        value = gen.throw(exc)
+                except StopIteration as e:
+                    return e.value
+                finally:
+                    _unimport_claim()
+                    _unimport_current = outer
+                try:
+                    value = yield value
+                    exc = None
+                except BaseException as e:
+                    exc = e  # close() included, re-raised by the workflow
         finally:
-            for mod in sys.modules:
-                if mod not in mods:
-                    log.debug(__name__, 'unimport %s', mod)
-                    del sys.modules[mod]
-            gc.collect()
-        return ret
+            _unimport_end(genfunc, mods)
     return inner
 
 
@@ -1,5 +1,6 @@
 import ubinascii
 import protobuf
+import streams
 
 from trezor import log
 from trezor import loop
@@ -13,15 +14,28 @@ from . import sessions
 
 _interface = None
 
+# messages are serialized into a shared buffer, the codecs encode the data
+# into reports synchronously so it is free again once write() returns
+_write_buffer = streams.ReusableWriter(128)
+
 _workflow_callbacks = {}  # wire type -> function returning workflow
 _workflow_args = {}  # wire type -> args
+_workflow_noui = set()  # wire types of workflows starting without the screen
+_reading = {}  # session id -> signal of the pending read()
 
 
-def register(wire_type, callback, *args):
+def register(wire_type, callback, *args, ui=True):
+    '''
+    Registers `callback` for messages of `wire_type`.  Workflows registered
+    with `ui=False` run concurrently with the workflows of other sessions and
+    take the screen only when they need it (see `workflow.acquire_ui()`).
+    '''
     if wire_type in _workflow_callbacks:
         raise KeyError('Message %d already registered' % wire_type)
     _workflow_callbacks[wire_type] = callback
     _workflow_args[wire_type] = args
+    if not ui:
+        _workflow_noui.add(wire_type)
 
 
 def setup(iface):
@@ -38,25 +52,33 @@ def setup(iface):
     loop.schedule_task(_dispatch_reports())
 
 
-async def read(session_id, *wire_types):
+async def read(session_id, *wire_types, pool=None):
+    '''
+    Reads a message of one of `wire_types`.  If `pool` (`protobuf.MessagePool`)
+    is given, message of its type is decoded in place into `pool.msg`.
+    '''
     log.info(__name__, 'session %x: read(%s)', session_id, wire_types)
     signal = loop.Signal()
-    sessions.listen(session_id, _handle_response, wire_types, signal)
-    return await signal
+    sessions.listen(session_id, _handle_response, wire_types, signal, pool)
+    _reading[session_id] = signal
+    try:
+        return await signal
+    finally:
+        _reading.pop(session_id, None)
 
 
 async def write(session_id, pbuf_msg):
     log.info(__name__, 'session %x: write(%s)', session_id, pbuf_msg)
     pbuf_type = pbuf_msg.__class__
-    msg_data = pbuf_type.dumps(pbuf_msg)
+    msg_data = pbuf_type.dumps(pbuf_msg, _write_buffer)
     msg_type = pbuf_type.MESSAGE_WIRE_TYPE
     sessions.get_codec(session_id).encode(
         session_id, msg_type, msg_data, _write_report)
 
 
-async def call(session_id, pbuf_msg, *response_types):
+async def call(session_id, pbuf_msg, *response_types, pool=None):
     await write(session_id, pbuf_msg)
-    return await read(session_id, *response_types)
+    return await read(session_id, *response_types, pool=pool)
 
 
 class FailureError(Exception):
@@ -72,17 +94,20 @@ class CloseWorkflow(Exception):
 
 
 def protobuf_workflow(session_id, msg_type, data_len, callback, *args):
-    return _build_protobuf(msg_type, _start_protobuf_workflow, session_id, callback, args)
+    ui = msg_type not in _workflow_noui
+    return _build_protobuf(msg_type, _start_protobuf_workflow, session_id, callback, args, ui)
 
 
-def _start_protobuf_workflow(pbuf_msg, session_id, callback, args):
+def _start_protobuf_workflow(pbuf_msg, session_id, callback, args, ui):
     wf = callback(session_id, pbuf_msg, *args)
-    wf = _wrap_protobuf_workflow(wf, session_id)
-    workflow.start(wf)
+    wf = _wrap_protobuf_workflow(wf, session_id, ui)
+    workflow.start(wf, ui)
 
 
-async def _wrap_protobuf_workflow(wf, session_id):
+async def _wrap_protobuf_workflow(wf, session_id, ui):
     try:
+        if ui:
+            await workflow.acquire_ui(session_id)
         result = await wf
 
     except CloseWorkflow:
@@ -105,6 +130,7 @@ async def _wrap_protobuf_workflow(wf, session_id):
         return result
 
     finally:
+        workflow.release_ui(session_id)
         if session_id in sessions.opened:
             sessions.listen(session_id, _handle_workflow)
 
@@ -116,8 +142,16 @@ def _build_protobuf(msg_type, callback, *args):
     return pbuf_type.load(target=builder)
 
 
-def _handle_response(session_id, msg_type, data_len, response_types, signal):
+def _build_protobuf_into(pool, callback, *args):
+    builder = protobuf.build_message_into(pool, callback, *args)
+    builder.send(None)
+    return pool.msg_type.load(target=builder)
+
+
+def _handle_response(session_id, msg_type, data_len, response_types, signal, pool):
     if msg_type in response_types:
+        if pool is not None and pool.msg_type.MESSAGE_WIRE_TYPE == msg_type:
+            return _build_protobuf_into(pool, signal.send)
         return _build_protobuf(msg_type, signal.send)
     else:
         signal.send(CloseWorkflow())
@@ -178,6 +212,12 @@ def _session_open(session_id=None):
 
 def _session_close(session_id):
     sessions.close(session_id)
+    # end the workflow of the session, whether it is reading or waiting for
+    # the screen, and hand the screen over to the next session
+    signal = _reading.pop(session_id, None)
+    if signal is not None:
+        signal.send(CloseWorkflow())
+    workflow.release_ui(session_id, CloseWorkflow())
     sessions.get_codec(session_id).encode_session_close(
         session_id, _write_report)
 
@@ -2,6 +2,8 @@ from micropython import const
 import ustruct
 import ubinascii
 
+from trezor.msg import Demux
+
 # trezor wire protocol #2:
 #
 # # hid report (64B)
@@ -126,6 +128,42 @@ Pass report payloads as `memoryview` for cheaper slicing.
         target.throw(EOFError())
 
 
+def decode_chunks(session_id, callback, *args):
+    '''Decode a wire message from the chunks reassembled by `trezor.msg.Demux`.
+
+Same as `decode_stream`, but receives `(event, msg_type, data_len, offset,
+chunk)` tuples of the demultiplexer events instead of report payloads, the
+reports are parsed and the checksum is verified natively.
+Chunks of a message that started before the first one received are dropped.
+Throws `MessageChecksumError` to target if the message is cut short by the
+header of another one.
+'''
+    event, msg_type, data_len, offset, chunk = yield  # read first chunk
+    while offset != 0:
+        # started listening in the middle of a message, wait for the next one
+        event, msg_type, data_len, offset, chunk = yield
+
+    target = callback(session_id, msg_type, data_len, *args)
+    target.send(None)
+
+    pos = 0
+    while True:
+        if offset != pos:
+            target.throw(MessageChecksumError())
+            return
+        if chunk:
+            target.send(chunk)
+        if event != Demux.CHUNK:
+            break
+        pos += len(chunk)
+        event, _, _, offset, chunk = yield  # read next chunk
+
+    if event == Demux.CHECKSUM:
+        target.throw(MessageChecksumError())
+    else:
+        target.throw(EOFError())
+
+
 def encode(session_id, msg_type, msg_data, callback):
     '''Encode a full wire message directly to reports and stream it to callback.
 
@@ -1,4 +1,5 @@
 from trezor import log
+from trezor import msg
 from trezor.crypto import random
 
 from . import codec_v1
@@ -7,6 +8,10 @@ from . import codec_v2
 opened = set()  # opened session ids
 readers = {}  # session id -> generator
 
+# v2 reports are reassembled natively, readers of v2 sessions get whole
+# messages or large chunks of them (see codec_v2.decode_chunks)
+_demux = msg.Demux(512)
+
 
 def generate():
     while True:
@@ -19,6 +24,8 @@ def open(session_id=None):
     if session_id is None:
         session_id = generate()
     log.info(__name__, 'session %x: open', session_id)
+    if session_id != codec_v1.SESSION:
+        _demux.open(session_id)
     opened.add(session_id)
     return session_id
 
@@ -27,6 +34,7 @@ def close(session_id):
     log.info(__name__, 'session %x: close', session_id)
     opened.discard(session_id)
     readers.pop(session_id, None)
+    _demux.close(session_id)
 
 
 def get_codec(session_id):
@@ -42,7 +50,10 @@ def listen(session_id, handler, *args):
     if session_id in readers:
         raise KeyError('Session %x is already being listened on' % session_id)
     log.info(__name__, 'session %x: listening', session_id)
-    decoder = get_codec(session_id).decode_stream(session_id, handler, *args)
+    if session_id == codec_v1.SESSION:
+        decoder = codec_v1.decode_stream(session_id, handler, *args)
+    else:
+        decoder = codec_v2.decode_chunks(session_id, handler, *args)
     decoder.send(None)
     readers[session_id] = decoder
 
@@ -55,16 +66,26 @@ def dispatch(report, open_callback, close_callback, unknown_callback):
     if codec_v1.detect(report):
         marker, session_id, report_data = codec_v1.parse_report(report)
     else:
-        marker, session_id, report_data = codec_v2.parse_report(report)
+        event = _demux.feed(report)
+        if event is None:
+            return  # no complete chunk yet
+        event, session_id, msg_type, data_len, offset, chunk = event
 
-        if marker == codec_v2.REP_MARKER_OPEN:
+        if event == msg.Demux.OPEN:
             log.debug(__name__, 'request for new session')
-            open_callback()
+            try:
+                open_callback()
+            except Exception as e:
+                log.exception(__name__, e)
             return
-        elif marker == codec_v2.REP_MARKER_CLOSE:
+        elif event == msg.Demux.CLOSE:
             log.debug(__name__, 'request for closing session %x', session_id)
             close_callback(session_id)
             return
+        elif event == msg.Demux.UNKNOWN:
+            report_data = codec_v2.parse_report(report)[2]
+        else:
+            report_data = (event, msg_type, data_len, offset, chunk)
 
     if session_id not in readers:
         log.warning(__name__, 'report on unknown session %x', session_id)
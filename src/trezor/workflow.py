@@ -4,6 +4,11 @@ _started = []
 _default = None
 _default_genfunc = None
 
+# workflows run concurrently, but only the workflows of one session at a time
+# own the screen.  the others wait for it in acquire_ui(), in order
+_ui_owner = None  # session id
+_ui_waiting = []  # [(session id, signal)]
+
 
 def start_default(genfunc):
     global _default
@@ -21,12 +26,61 @@ def close_default():
     _default = None
 
 
-def start(workflow):
-    if _default is not None:
+def start(workflow, ui=True):
+    '''
+    Starts `workflow`.  Workflows not using the screen (`ui=False`) run along
+    the default workflow and the workflows of other sessions, they call
+    `acquire_ui()` before using the screen.
+    '''
+    if ui and _default is not None:
         close_default()
     _started.append(workflow)
     log.info(__name__, 'start %s', workflow)
-    loop.schedule_task(_watch(workflow))
+    watcher = _watch(workflow)
+    loop.profile_as(watcher, workflow)
+    loop.schedule_task(watcher)
+
+
+async def acquire_ui(session_id):
+    '''
+    Waits until the screen is free and takes it for the workflows of
+    `session_id`, closing the default workflow.  The screen is kept until
+    `release_ui()`.
+    '''
+    global _ui_owner
+    if _ui_owner == session_id:
+        return
+    if _ui_owner is not None:
+        log.info(__name__, 'session %x: waiting for ui', session_id)
+        signal = loop.Signal()
+        _ui_waiting.append((session_id, signal))
+        await signal  # ownership is handed over in release_ui()
+    else:
+        _ui_owner = session_id
+    if _default is not None:
+        close_default()
+
+
+def release_ui(session_id, exc=None):
+    '''
+    Hands the screen over to the next waiting session.  If `session_id` is
+    still waiting for the screen, it is dequeued, and its `acquire_ui()`
+    raises `exc` if given.
+    '''
+    global _ui_owner
+    for w in _ui_waiting:
+        if w[0] == session_id:
+            _ui_waiting.remove(w)
+            if exc is not None:
+                w[1].send(exc)
+            break
+    if _ui_owner != session_id:
+        return
+    if _ui_waiting:
+        _ui_owner, signal = _ui_waiting.pop(0)
+        signal.send(None)
+    else:
+        _ui_owner = None
 
 
 async def _watch(workflow):
@@ -34,5 +88,5 @@ async def _watch(workflow):
         return await workflow
     finally:
         _started.remove(workflow)
-        if not _started and _default_genfunc is not None:
+        if _ui_owner is None and _default is None and _default_genfunc is not None:
             start_default(_default_genfunc)
@@ -0,0 +1,38 @@
+# Compare builds with and without the unrolled SHA-2 transforms:
+#
+#   TREZOR_SHA2_UNROLL=0 make clean_unix build_unix bench
+#   TREZOR_SHA2_UNROLL=1 make clean_unix build_unix bench
+#
+# (firmware: make build_firmware TREZOR_SHA2_UNROLL=0|1)
+
+from common import *
+
+import utime
+
+from trezor.crypto import bip32
+from trezor.crypto import pbkdf2
+from trezor.crypto.hashlib import sha512
+
+
+def bench(name, func, count):
+    start = utime.ticks_us()
+    for i in range(count):
+        func()
+    delta = utime.ticks_diff(utime.ticks_us(), start)
+    print('%-24s %8d us total %8d us/op' % (name, delta, delta // count))
+
+
+class BenchCryptoSha512(unittest.TestCase):
+
+    def test_bench(self):
+        data = bytes(16 * 1024)
+        seed = unhexlify('000102030405060708090a0b0c0d0e0f')
+        bench('sha512 16 KiB', lambda: sha512(data).digest(), 16)
+        bench('pbkdf2 2048 rounds', lambda: pbkdf2('hmac-sha512', 'mnemonic', 'salt', 2048).key(), 4)
+        bench('bip32 from_seed', lambda: bip32.from_seed(seed, 'secp256k1'), 64)
+        node = bip32.from_seed(seed, 'secp256k1')
+        bench('bip32 derive hardened', lambda: node.clone().derive(0x80000000), 64)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,29 @@
+from common import *
+
+from trezor import loop
+from trezor.crypto import bip39
+
+from apps.common.seed import derive_seed
+
+class TestSeed(unittest.TestCase):
+
+    def test_derive_seed(self):
+        v = [
+            'abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about',
+            'legal winner thank year wave sausage worth useful legal winner thank yellow',
+        ]
+        for m in v:
+            for p in ['', 'TREZOR']:
+                deriver = derive_seed(m, p)
+                steps = 0
+                try:
+                    while True:
+                        self.assertIsInstance(deriver.send(None), loop.Sleep)
+                        steps += 1
+                except StopIteration as e:
+                    seed = e.value
+                self.assertTrue(steps > 1)
+                self.assertEqual(seed, bip39.seed(m, p))
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,64 @@
+// host test of the bootloader upload stream parsing, see "make test_bootloader"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common.h"
+#include "flash.h"
+#include "image.h"
+#include "upload.h"
+
+// nothing is programmed while the upload fits into the first buffer
+
+bool flash_unlock(void) { return true; }
+bool flash_lock(void) { return true; }
+int flash_sector_of(uint32_t address) { return 5; }
+bool flash_erase_sector(uint8_t sector) { assert(0); return false; }
+bool flash_write_word(uint32_t address, uint32_t data) { assert(0); return false; }
+
+void image_hash_init(image_hash_ctx *ctx, uint32_t hdrlen) { assert(0); }
+void image_hash_update(image_hash_ctx *ctx, const uint8_t *data, uint32_t len) { assert(0); }
+void image_hash_final(image_hash_ctx *ctx, uint8_t hash[BLAKE2S_DIGEST_LENGTH]) { assert(0); }
+bool image_parse_header(const uint8_t *data, uint32_t magic, uint32_t maxsize, image_header *hdr) { assert(0); return false; }
+bool image_check_hash(const uint8_t hash[BLAKE2S_DIGEST_LENGTH], const image_header *hdr, const vendor_header *vhdr) { assert(0); return false; }
+bool vendor_parse_header(const uint8_t *data, vendor_header *vhdr) { assert(0); return false; }
+bool vendor_check_signature(const uint8_t *data, const vendor_header *vhdr) { assert(0); return false; }
+
+#define VHDRLEN 0x0100
+#define CODELEN 0x030201
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+int main(void)
+{
+    uint8_t data[VHDRLEN + 16];
+    // no zero bytes, so a partially captured length is never zero
+    memset(data, 0xAA, sizeof(data));
+    put_u32(data + 4, VHDRLEN);
+    put_u32(data + VHDRLEN + 12, CODELEN);
+    const uint32_t total = VHDRLEN + HEADER_SIZE + CODELEN;
+
+    // both headers split into two writes at every offset
+    for (uint32_t k = 0; k <= sizeof(data); k++) {
+        upload_start();
+        assert(upload_write(data, k));
+        assert(upload_total() == (k == sizeof(data) ? total : 0));
+        assert(upload_write(data + k, sizeof(data) - k));
+        assert(upload_total() == total);
+    }
+
+    // one byte at a time
+    upload_start();
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        assert(upload_total() == 0);
+        assert(upload_write(data + i, 1));
+    }
+    assert(upload_total() == total);
+
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,84 @@
+from common import *
+
+import protobuf
+from streams import StreamReader, ReusableWriter
+
+from trezor.messages.HDNodePathType import HDNodePathType
+from trezor.messages.HDNodeType import HDNodeType
+from trezor.messages.MultisigRedeemScriptType import MultisigRedeemScriptType
+from trezor.messages.TxAck import TxAck
+from trezor.messages.TransactionType import TransactionType
+from trezor.messages.TxInputType import TxInputType
+from trezor.messages.TxOutputBinType import TxOutputBinType
+from trezor.messages.TxRequest import TxRequest
+from trezor.messages.TxRequestDetailsType import TxRequestDetailsType
+from trezor.messages.TxRequestSerializedType import TxRequestSerializedType
+
+
+def load(msg_type, data, builder):
+    builder.send(None)
+    loader = msg_type.load(StreamReader(data, len(data)), builder)
+    try:
+        while True:
+            loader.send(None)
+    except StopIteration as e:
+        return e.value
+
+
+class TestProtobuf(unittest.TestCase):
+
+    def test_build_message_into(self):
+        acks = [
+            TxAck(tx=TransactionType(inputs=[TxInputType(address_n=[44 | 0x80000000, 0, 0], prev_hash=b'\x01' * 32, prev_index=1)])),
+            TxAck(tx=TransactionType(bin_outputs=[TxOutputBinType(amount=12345, script_pubkey=b'\x76\xa9')])),
+            TxAck(tx=TransactionType(version=1, lock_time=0, inputs_cnt=2, outputs_cnt=1)),
+            TxAck(tx=TransactionType(inputs=[TxInputType(address_n=[1], prev_hash=b'\x02' * 32, prev_index=0)])),
+        ]
+        pool = protobuf.MessagePool(TxAck)
+        first = None
+        for ack in acks:
+            data = TxAck.dumps(ack)
+            fresh = load(TxAck, data, protobuf.build_message(TxAck))
+            reused = load(TxAck, data, protobuf.build_message_into(pool))
+            self.assertTrue(reused is pool.msg)
+            self.assertEqual(reused, fresh)
+            if first is None:
+                first = (reused.tx, reused.tx.inputs, reused.tx.inputs[0])
+        # nested messages and lists are reused
+        self.assertTrue(pool.msg.tx is first[0])
+        self.assertTrue(pool.msg.tx.inputs is first[1])
+        self.assertTrue(pool.msg.tx.inputs[0] is first[2])
+
+    def test_copy_message(self):
+        node = HDNodeType(depth=1, fingerprint=2, child_num=3, chain_code=b'\x04' * 32, public_key=b'\x02' * 33)
+        multisig = MultisigRedeemScriptType(pubkeys=[HDNodePathType(node=node, address_n=[0, 5])], signatures=[b''], m=1)
+        acks = [
+            TxAck(tx=TransactionType(inputs=[TxInputType(address_n=[1, 2], prev_hash=b'\x01' * 32, prev_index=1, multisig=multisig)])),
+            TxAck(tx=TransactionType(inputs=[TxInputType(address_n=[3], prev_hash=b'\x02' * 32, prev_index=0, multisig=MultisigRedeemScriptType(pubkeys=[HDNodePathType(node=node, address_n=[7])], signatures=[b'\x30'], m=1))])),
+        ]
+        data = [TxAck.dumps(ack) for ack in acks]
+        fresh = [load(TxAck, d, protobuf.build_message(TxAck)).tx.inputs[0] for d in data]
+        pool = protobuf.MessagePool(TxAck)
+        txi = load(TxAck, data[0], protobuf.build_message_into(pool)).tx.inputs[0]
+        copy = protobuf.copy_message(txi)
+        self.assertEqual(copy, fresh[0])
+        load(TxAck, data[1], protobuf.build_message_into(pool))
+        self.assertEqual(txi, fresh[1])
+        # the copy is not overwritten by the next decode into the pool
+        self.assertEqual(copy, fresh[0])
+
+    def test_dumps_reusable(self):
+        req = TxRequest(request_type=0,
+                        details=TxRequestDetailsType(request_index=3),
+                        serialized=TxRequestSerializedType(signature_index=0, signature=b'\x30' * 71, serialized_tx=b'\xab' * 100))
+        writer = ReusableWriter(16)
+        for i in range(3):
+            self.assertEqual(bytes(TxRequest.dumps(req, writer)), bytes(TxRequest.dumps(req)))
+        buffer = writer.buffer
+        req.details.request_index = 4
+        self.assertEqual(bytes(TxRequest.dumps(req, writer)), bytes(TxRequest.dumps(req)))
+        self.assertTrue(writer.buffer is buffer)
+
+
+if __name__ == '__main__':
+    unittest.main()
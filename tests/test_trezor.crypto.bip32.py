@@ -27,6 +27,25 @@ class TestCryptoBip32(unittest.TestCase):
         with self.assertRaises(ValueError):
             bip32.from_seed(s, 'foobar')
 
+    def test_cached_root(self):
+        s = unhexlify('000102030405060708090a0b0c0d0e0f')
+        bip32.clear_cache()
+        self.assertIsNone(bip32.cached_root(SECP256K1_NAME))
+        bip32.cache_seed(s)
+        for c in [SECP256K1_NAME, 'nist256p1', 'ed25519', SECP256K1_NAME]:
+            n = bip32.cached_root(c)
+            m = bip32.from_seed(s, c)
+            self.assertEqual(n.private_key(), m.private_key())
+            self.assertEqual(n.chain_code(), m.chain_code())
+        # returned nodes are copies, deriving them must not touch the cache
+        n = bip32.cached_root(SECP256K1_NAME)
+        n.derive(HARDENED | 44)
+        self.assertEqual(bip32.cached_root(SECP256K1_NAME).depth(), 0)
+        with self.assertRaises(ValueError):
+            bip32.cached_root('foobar')
+        bip32.clear_cache()
+        self.assertIsNone(bip32.cached_root(SECP256K1_NAME))
+
     def test_secp256k1_vector_1_derive(self):
         # pylint: disable=C0301
         # test vector 1 from https://en.bitcoin.it/wiki/BIP_0032_TestVectors
@@ -0,0 +1,60 @@
+from common import *
+
+import ustruct
+
+from trezor import loop
+from trezor import telemetry
+
+def stepper(n):
+    for i in range(n):
+        yield loop.Signal()
+
+def failer():
+    yield loop.Signal()
+    raise ValueError()
+
+class TestLoop(unittest.TestCase):
+
+    def test_profile(self):
+        loop.start_profiling()
+        a = stepper(3)
+        b = stepper(1)
+        for i in range(4):
+            loop._step_task(a, None)
+        loop._step_task(b, None)
+        loop._step_task(b, None)
+        table = loop.profile()
+        self.assertEqual(len(table), 1)
+        name, steps, total, worst = table[0]
+        self.assertEqual(name, 'stepper')
+        self.assertEqual(steps, 6)
+        self.assertTrue(worst <= total)
+        loop.stop_profiling()
+        self.assertEqual(loop.profile(), [])
+
+    def test_profile_as(self):
+        loop.start_profiling()
+        signal = loop.Signal()
+        waiter = loop.Wait((stepper(1), signal))
+        waiter.handle(stepper(0))
+        for task in waiter.scheduled:
+            loop._step_task(task, None)
+        names = [row[0] for row in loop.profile()]
+        self.assertTrue('stepper' in names)
+        self.assertTrue('Signal' in names)
+        self.assertFalse('_wait' in names)
+        loop.stop_profiling()
+
+    def test_telemetry(self):
+        telemetry.reset()
+        a = stepper(1)
+        b = failer()
+        for i in range(2):
+            loop._step_task(a, None)
+            loop._step_task(b, None)
+        # finishing and failing steps are recorded too
+        steps = ustruct.unpack_from('<I', telemetry.snapshot(), 5 * 4)[0]
+        self.assertEqual(steps, 4)
+
+if __name__ == '__main__':
+    unittest.main()
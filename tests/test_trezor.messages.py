@@ -0,0 +1,29 @@
+from common import *
+
+import sys
+
+from trezor import messages
+from trezor.messages import wire_types
+
+
+class TestMessages(unittest.TestCase):
+
+    def test_get_protobuf_type_name(self):
+        for name in dir(wire_types):
+            value = getattr(wire_types, name)
+            if isinstance(value, int):
+                self.assertEqual(messages.get_protobuf_type_name(value), name)
+        self.assertEqual(messages.get_protobuf_type_name(0xFFFF), None)
+
+    def test_get_protobuf_type(self):
+        ping = messages.get_protobuf_type(wire_types.Ping)
+        self.assertEqual(ping.MESSAGE_WIRE_TYPE, wire_types.Ping)
+        # survives unimport and stays the class workflows import
+        del sys.modules['trezor.messages.Ping']
+        self.assertTrue(messages.get_protobuf_type(wire_types.Ping) is ping)
+        from trezor.messages.Ping import Ping
+        self.assertTrue(Ping is ping)
+
+
+if __name__ == '__main__':
+    unittest.main()
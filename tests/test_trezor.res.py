@@ -0,0 +1,30 @@
+from common import *
+
+from trezor import res
+
+class TestRes(unittest.TestCase):
+
+    def test_hash(self):
+        # FNV-1a test vectors
+        self.assertEqual(res.hash(''), 0x811c9dc5)
+        self.assertEqual(res.hash('a'), 0xe40c292c)
+        self.assertEqual(res.hash('foobar'), 0xbf9cf968)
+
+    def test_get_missing(self):
+        self.assertIsNone(res.get(res.hash('trezor/res/missing.toif')))
+
+    def test_get(self):
+        data = res.get(res.hash('trezor/res/pin_close.toig'))
+        if data is None:
+            return  # resource pack was not generated
+        with open('../src/trezor/res/pin_close.toig', 'rb') as f:
+            self.assertEqual(bytes(data), f.read())
+
+    def test_load(self):
+        name = '../src/trezor/res/pin_close.toig'
+        with open(name, 'rb') as f:
+            data = f.read()
+        self.assertEqual(bytes(res.load(name)), data)
+
+if __name__ == '__main__':
+    unittest.main()
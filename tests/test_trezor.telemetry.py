@@ -0,0 +1,45 @@
+from common import *
+
+import ustruct
+
+from trezor import telemetry
+
+class TestTelemetry(unittest.TestCase):
+
+    def test_record(self):
+        telemetry.reset()
+        telemetry.record(telemetry.STEP, 0)
+        telemetry.record(telemetry.STEP, 5)
+        telemetry.record(telemetry.STEP, 100000000)
+        s = telemetry.snapshot()
+        self.assertEqual(s[0:4], b'TLM1')
+        step = 5 * 4
+        count, total, mx = ustruct.unpack_from('<3I', s, step)
+        self.assertEqual(count, 3)
+        self.assertEqual(total, 100000005)
+        self.assertEqual(mx, 100000000)
+        buckets = ustruct.unpack_from('<16I', s, step + 12)
+        self.assertEqual(buckets[0], 1)
+        self.assertEqual(buckets[2], 1)
+        self.assertEqual(buckets[15], 1)
+
+    def test_wait(self):
+        telemetry.reset()
+        task = object()
+        start = telemetry.task_resumed(task)
+        telemetry.task_suspended(task, start, telemetry.WAIT_SIGNAL)
+        telemetry.task_resumed(task)
+        s = telemetry.snapshot()
+        hist = 5 * 4 + telemetry.WAIT_SIGNAL * 19 * 4
+        self.assertEqual(ustruct.unpack_from('<I', s, hist)[0], 1)
+        self.assertEqual(ustruct.unpack_from('<I', s, 5 * 4)[0], 1)
+
+    def test_heap_report(self):
+        total, free, largest = telemetry.heap_info()
+        self.assertTrue(0 < largest <= free <= total)
+        head = telemetry.heap_report().split(b'\n')[0].split()
+        self.assertEqual(head[0], b'heap')
+        self.assertEqual(int(head[1]), total)
+
+if __name__ == '__main__':
+    unittest.main()
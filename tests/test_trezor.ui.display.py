@@ -39,6 +39,15 @@ class TestDisplay(unittest.TestCase):
     def test_qrcode(self):
         display.qrcode(0, 0, 'Test', 4)
 
+    def test_qrcode_prepare(self):
+        qr = display.qrcode_prepare('Test')
+        side = qr[0]
+        self.assertEqual(side, 21)
+        self.assertEqual(len(qr), 1 + (side * side + 7) // 8)
+        display.qrcode_bitmap(120, 120, qr, 4)
+        with self.assertRaises(ValueError):
+            display.qrcode_bitmap(120, 120, qr[:-1], 4)
+
     def test_loader(self):
         display.loader(333, 0, 0xFFFF, 0x0000)
 
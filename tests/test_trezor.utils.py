@@ -1,5 +1,8 @@
 from common import *
 
+import sys
+
+from trezor import loop
 from trezor import utils
 
 class TestUtils(unittest.TestCase):
@@ -12,5 +15,75 @@ class TestUtils(unittest.TestCase):
             self.assertEqual(c[i].stop, 100 if (i == 14) else (i + 1) * 7)
             self.assertEqual(c[i].step, 1)
 
+    def test_warm_start(self):
+
+        @utils.unimport
+        def load_rlp():
+            from trezor.crypto import rlp
+
+        @utils.unimport
+        def load_der():
+            from trezor.crypto import der
+
+        utils.warm_start(0)
+        load_rlp()
+        self.assertFalse('trezor.crypto.rlp' in sys.modules)
+        utils.warm_start(1)
+        hits, misses, evictions, resident = utils.warm_stats()
+        load_rlp()
+        self.assertTrue('trezor.crypto.rlp' in sys.modules)
+        load_rlp()
+        self.assertEqual(utils.warm_stats(), (hits + 1, misses + 1, evictions, 1))
+        # least recently used is evicted
+        load_der()
+        self.assertFalse('trezor.crypto.rlp' in sys.modules)
+        self.assertTrue('trezor.crypto.der' in sys.modules)
+        self.assertEqual(utils.warm_stats(), (hits + 1, misses + 2, evictions + 1, 1))
+        utils.warm_start(0)
+        self.assertFalse('trezor.crypto.der' in sys.modules)
+
+    def test_unimport_overlapping(self):
+
+        @utils.unimport
+        async def long_flow():
+            from trezor.crypto import rlp
+            await loop.Sleep(0)
+            from trezor.crypto import rlp
+            return rlp
+
+        @utils.unimport
+        async def short_flow():
+            from trezor.crypto import der
+            await loop.Sleep(0)
+
+        utils.warm_start(0)
+        a = long_flow()
+        b = short_flow()
+        a.send(None)
+        b.send(None)
+        rlp = sys.modules['trezor.crypto.rlp']
+        with self.assertRaises(StopIteration):
+            b.send(None)
+        # each workflow unimports only what it imported itself
+        self.assertTrue(sys.modules['trezor.crypto.rlp'] is rlp)
+        self.assertFalse('trezor.crypto.der' in sys.modules)
+        try:
+            a.send(None)
+        except StopIteration as e:
+            self.assertTrue(e.value is rlp)
+        self.assertFalse('trezor.crypto.rlp' in sys.modules)
+
+        # the default workflow or a suspended one does not hold back others
+        a = long_flow()
+        a.send(None)
+        b = short_flow()
+        b.send(None)
+        with self.assertRaises(StopIteration):
+            b.send(None)
+        self.assertFalse('trezor.crypto.der' in sys.modules)
+        self.assertTrue('trezor.crypto.rlp' in sys.modules)
+        a.close()
+        self.assertFalse('trezor.crypto.rlp' in sys.modules)
+
 if __name__ == '__main__':
     unittest.main()
@@ -5,6 +5,7 @@ import ubinascii
 
 from trezor.crypto import random
 from trezor.utils import chunks
+from trezor.msg import Demux
 
 from trezor.wire import codec_v2
 
@@ -152,6 +153,98 @@ class TestWireCodec(unittest.TestCase):
                 self.assertEqual(record[i], data_chunks[i])
             self.assertIsInstance(record[-1], EOFError)
 
+    def test_decode_chunks_generated_range(self):
+        session_id = 0xdeadbeef
+        msg_type = 0xabcdef12
+        demux = Demux(512)
+        demux.open(session_id)
+        for data_len in range(0, 1500, 7):
+            data = random.bytes(data_len)
+            reports = []
+            codec_v2.encode(session_id, msg_type, data, lambda r: reports.append(bytes(r)))
+            if data_len % 2:
+                # corrupt the checksum
+                footer = 8 + data_len
+                i, j = footer // 59, 5 + footer % 59
+                reports[i] = reports[i][:j] + bytes([reports[i][j] ^ 1]) + reports[i][j + 1:]
+
+            record = []
+            def genfunc(*args):
+                self.assertEqual(args, (session_id, msg_type, data_len, 'dummy'))
+                while True:
+                    try:
+                        record.append(bytes((yield)))
+                    except Exception as e:
+                        record.append(e)
+            decoder = codec_v2.decode_chunks(session_id, genfunc, 'dummy')
+            decoder.send(None)
+
+            res = 1
+            try:
+                for r in reports:
+                    event = demux.feed(r)
+                    if event is not None:
+                        event, sid, t, l, offset, chunk = event
+                        self.assertEqual((sid, t, l), (session_id, msg_type, data_len))
+                        decoder.send((event, t, l, offset, chunk))
+            except StopIteration as e:
+                res = e.value
+            self.assertEqual(res, None)
+            self.assertEqual(b''.join(record[:-1]), data)
+            if data_len % 2:
+                self.assertIsInstance(record[-1], codec_v2.MessageChecksumError)
+            else:
+                self.assertIsInstance(record[-1], EOFError)
+
+    def test_decode_chunks_partial(self):
+        session_id = 0xdeadbeef
+        demux = Demux(512)
+        demux.open(session_id)
+        first = []
+        second = []
+        codec_v2.encode(session_id, 0x1234, random.bytes(1000), lambda r: first.append(bytes(r)))
+        codec_v2.encode(session_id, 0x5678, b'\x01' * 100, lambda r: second.append(bytes(r)))
+
+        record = []
+        def genfunc(*args):
+            record.append(args)
+            while True:
+                try:
+                    record.append(bytes((yield)))
+                except Exception as e:
+                    record.append(e)
+
+        def feed(decoder, reports):
+            try:
+                for r in reports:
+                    event = demux.feed(r)
+                    if event is not None:
+                        event, _, t, l, offset, chunk = event
+                        decoder.send((event, t, l, offset, chunk))
+            except StopIteration:
+                pass
+
+        # listening started in the middle of a message, it is dropped
+        for r in first[:10]:
+            demux.feed(r)
+        decoder = codec_v2.decode_chunks(session_id, genfunc)
+        decoder.send(None)
+        feed(decoder, first[10:])
+        self.assertEqual(record, [])
+        feed(decoder, second)
+        self.assertEqual(record[0], (session_id, 0x5678, 100))
+        self.assertEqual(record[1], b'\x01' * 100)
+        self.assertIsInstance(record[2], EOFError)
+
+        # message cut short by the header of another one
+        del record[:]
+        decoder = codec_v2.decode_chunks(session_id, genfunc)
+        decoder.send(None)
+        feed(decoder, first[:10])
+        feed(decoder, second)
+        self.assertEqual(record[0], (session_id, 0x1234, 1000))
+        self.assertIsInstance(record[-1], codec_v2.MessageChecksumError)
+
     def test_encode_empty(self):
         record = []
         target = self._record(record)()
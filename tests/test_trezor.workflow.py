@@ -0,0 +1,42 @@
+from common import *
+
+from trezor import loop
+from trezor import workflow
+
+class TestWorkflow(unittest.TestCase):
+
+    def test_ui_ownership(self):
+        a = workflow.acquire_ui(1)
+        with self.assertRaises(StopIteration):
+            a.send(None)  # free, taken at once
+        with self.assertRaises(StopIteration):
+            workflow.acquire_ui(1).send(None)  # owned already
+        b = workflow.acquire_ui(2)
+        c = workflow.acquire_ui(3)
+        self.assertTrue(isinstance(b.send(None), loop.Signal))
+        self.assertTrue(isinstance(c.send(None), loop.Signal))
+        # handed over in order of the requests
+        workflow.release_ui(1)
+        self.assertEqual(workflow._ui_owner, 2)
+        # releasing a waiting session only dequeues it
+        workflow.release_ui(3)
+        self.assertEqual(workflow._ui_owner, 2)
+        workflow.release_ui(2)
+        self.assertEqual(workflow._ui_owner, None)
+        self.assertEqual(workflow._ui_waiting, [])
+    def test_ui_release_waiting(self):
+        with self.assertRaises(StopIteration):
+            workflow.acquire_ui(1).send(None)
+        b = workflow.acquire_ui(2)
+        signal = b.send(None)
+        # the closed session stops waiting for the screen
+        exc = Exception()
+        workflow.release_ui(2, exc)
+        self.assertIs(signal.value, exc)
+        self.assertEqual(workflow._ui_waiting, [])
+        self.assertEqual(workflow._ui_owner, 1)
+        workflow.release_ui(1)
+        self.assertEqual(workflow._ui_owner, None)
+
+if __name__ == '__main__':
+    unittest.main()